@@ -0,0 +1,475 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+using namespace std;
+
+class Executor;
+
+// Fire-and-forget coroutine. It starts suspended and only runs once an
+// executor spawns it; the frame frees itself when the body returns.
+struct Task {
+    struct promise_type {
+        Executor* executor = nullptr;
+
+        Task get_return_object() {
+            return Task{ coroutine_handle<promise_type>::from_promise(*this) };
+        }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_never final_suspend() noexcept { return {}; }
+        void return_void();
+        void unhandled_exception() { terminate(); }
+    };
+
+    coroutine_handle<promise_type> handle;
+};
+
+class Executor {
+protected:
+    atomic<int> live_tasks;
+
+public:
+    Executor() : live_tasks(0) {}
+    virtual ~Executor() {}
+
+    virtual void schedule(coroutine_handle<> h) = 0;
+
+    // Called from a task's return_void(), just before its frame is destroyed.
+    virtual void task_finished() { --live_tasks; }
+
+    int unfinished_tasks() const { return live_tasks.load(); }
+
+    void spawn(Task task) {
+        task.handle.promise().executor = this;
+        ++live_tasks;
+        schedule(task.handle);
+    }
+};
+
+void Task::promise_type::return_void() {
+    if (executor != nullptr)
+        executor->task_finished();
+}
+
+// Runs everything on the calling thread. Scheduling is a deque push, so a
+// hop between stages costs no locking and no wakeup at all.
+class SingleThreadExecutor : public Executor {
+private:
+    deque<coroutine_handle<>> ready;
+
+public:
+    void schedule(coroutine_handle<> h) override {
+        ready.push_back(h);
+    }
+
+    // Returns once nothing is runnable: either every task finished or the
+    // rest are blocked on channels nobody will touch again. Returns how many
+    // are still suspended; closing their channels and calling run() again
+    // lets them finish.
+    int run() {
+        while (!ready.empty()) {
+            coroutine_handle<> h = ready.front();
+            ready.pop_front();
+            h.resume();
+        }
+        return unfinished_tasks();
+    }
+};
+
+// Shared run queue for a fixed set of worker threads. Workers only sleep on
+// the condition variable when the queue is empty, and schedule() only signals
+// when one of them is actually asleep.
+class ThreadPoolExecutor : public Executor {
+private:
+    deque<coroutine_handle<>> ready;
+    mutex queue_mutex;
+    condition_variable queue_cv;
+    int idle_workers;
+    int worker_count;
+    bool stalled;
+
+    void worker() {
+        unique_lock<mutex> lock(queue_mutex);
+        while (true) {
+            if (!ready.empty()) {
+                coroutine_handle<> h = ready.front();
+                ready.pop_front();
+                lock.unlock();
+                h.resume();
+                lock.lock();
+            }
+            else if (live_tasks.load() == 0 || stalled) {
+                return;
+            }
+            else if (idle_workers == worker_count - 1) {
+                // Every other worker is asleep and nothing is queued, so no
+                // task is running that could wake one of the suspended ones.
+                stalled = true;
+                queue_cv.notify_all();
+                return;
+            }
+            else {
+                ++idle_workers;
+                queue_cv.wait(lock);
+                --idle_workers;
+            }
+        }
+    }
+
+public:
+    ThreadPoolExecutor() : idle_workers(0), worker_count(0), stalled(false) {}
+
+    void schedule(coroutine_handle<> h) override {
+        lock_guard<mutex> guard(queue_mutex);
+        ready.push_back(h);
+        if (idle_workers > 0)
+            queue_cv.notify_one();
+    }
+
+    void task_finished() override {
+        if (--live_tasks == 0) {
+            lock_guard<mutex> guard(queue_mutex);
+            queue_cv.notify_all();
+        }
+    }
+
+    // Blocks until every spawned task has finished, or until the remaining
+    // ones are all suspended on channels that no running task can reach.
+    // Returns how many are still suspended, as SingleThreadExecutor::run()
+    // does. Only tasks may use the channels while this runs.
+    int run(int thread_count) {
+        if (thread_count < 1) thread_count = 1;
+        worker_count = thread_count;
+        stalled = false;
+
+        vector<thread> workers;
+        for (int i = 0; i < thread_count; ++i)
+            workers.emplace_back([this]() { worker(); });
+        for (thread& th : workers)
+            th.join();
+        return unfinished_tasks();
+    }
+};
+
+// Bounded channel between coroutines. Values sit in a ring buffer; a sender
+// that finds a receiver already waiting hands the value straight to it, and
+// a receiver that frees a slot pulls the first blocked sender's value in.
+// Woken coroutines are handed to the executor, never to a condition variable.
+// T must be default-constructible (the ring buffer is a plain array) and
+// movable.
+template <typename T>
+class AsyncChannel {
+    static_assert(is_default_constructible_v<T>, "AsyncChannel<T> needs a default-constructible T");
+    static_assert(is_move_assignable_v<T>, "AsyncChannel<T> needs a move-assignable T");
+
+private:
+    struct Waiter {
+        coroutine_handle<> handle;
+        optional<T> value;      // receivers: the delivered value; senders: the pending one
+        bool ok = false;
+        Waiter* next_waiter = nullptr;
+    };
+
+    // FIFO of suspended coroutines, linked through the waiters themselves.
+    struct WaitQueue {
+        Waiter* head = nullptr;
+        Waiter* tail = nullptr;
+
+        bool empty() const { return head == nullptr; }
+
+        void push(Waiter* w) {
+            w->next_waiter = nullptr;
+            if (tail == nullptr) head = w;
+            else tail->next_waiter = w;
+            tail = w;
+        }
+
+        Waiter* pop() {
+            Waiter* w = head;
+            head = w->next_waiter;
+            if (head == nullptr) tail = nullptr;
+            return w;
+        }
+    };
+
+    T* buffer;
+    int capacity;
+    int buffer_head;
+    int buffer_count;
+    bool closed;
+    WaitQueue senders;
+    WaitQueue receivers;
+    mutex channel_mutex;
+    Executor& executor;
+
+    // Takes the next value from the buffer or, for an unbuffered channel,
+    // straight from a blocked sender. Caller holds channel_mutex.
+    bool take_locked(optional<T>& out) {
+        if (buffer_count > 0) {
+            out = std::move(buffer[buffer_head]);
+            buffer_head = (buffer_head + 1) % capacity;
+            --buffer_count;
+
+            if (!senders.empty()) {
+                Waiter* sender = senders.pop();
+                buffer[(buffer_head + buffer_count) % capacity] = std::move(*sender->value);
+                ++buffer_count;
+                sender->ok = true;
+                executor.schedule(sender->handle);
+            }
+            return true;
+        }
+
+        if (!senders.empty()) {
+            Waiter* sender = senders.pop();
+            out = std::move(sender->value);
+            sender->ok = true;
+            executor.schedule(sender->handle);
+            return true;
+        }
+        return false;
+    }
+
+public:
+    class SendAwaiter {
+    private:
+        AsyncChannel& channel;
+        Waiter waiter;
+
+    public:
+        SendAwaiter(AsyncChannel& ch, T value) : channel(ch) { waiter.value = std::move(value); }
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(coroutine_handle<> h) {
+            lock_guard<mutex> guard(channel.channel_mutex);
+            if (channel.closed) {
+                waiter.ok = false;
+                return false;
+            }
+
+            if (!channel.receivers.empty()) {
+                Waiter* receiver = channel.receivers.pop();
+                receiver->value = std::move(waiter.value);
+                receiver->ok = true;
+                channel.executor.schedule(receiver->handle);
+                waiter.ok = true;
+                return false;
+            }
+
+            if (channel.buffer_count < channel.capacity) {
+                channel.buffer[(channel.buffer_head + channel.buffer_count) % channel.capacity] =
+                    std::move(*waiter.value);
+                ++channel.buffer_count;
+                waiter.ok = true;
+                return false;
+            }
+
+            waiter.handle = h;
+            channel.senders.push(&waiter);
+            return true;
+        }
+
+        // false when the channel was closed before the value was taken.
+        bool await_resume() const noexcept { return waiter.ok; }
+    };
+
+    class ReceiveAwaiter {
+    private:
+        AsyncChannel& channel;
+        Waiter waiter;
+
+    public:
+        ReceiveAwaiter(AsyncChannel& ch) : channel(ch) {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(coroutine_handle<> h) {
+            lock_guard<mutex> guard(channel.channel_mutex);
+            if (channel.take_locked(waiter.value) || channel.closed)
+                return false;
+
+            waiter.handle = h;
+            channel.receivers.push(&waiter);
+            return true;
+        }
+
+        // nullopt once the channel is closed and drained.
+        optional<T> await_resume() { return std::move(waiter.value); }
+    };
+
+    class ReceiveManyAwaiter {
+    private:
+        AsyncChannel& channel;
+        Waiter waiter;
+        int max_count;
+        vector<T> batch;
+
+        void drain_locked() {
+            optional<T> value;
+            while ((int)batch.size() < max_count && channel.take_locked(value))
+                batch.push_back(std::move(*value));
+        }
+
+    public:
+        ReceiveManyAwaiter(AsyncChannel& ch, int max) : channel(ch), max_count(max) {}
+
+        // Asking for nothing returns an empty batch at once.
+        bool await_ready() const noexcept { return max_count <= 0; }
+
+        bool await_suspend(coroutine_handle<> h) {
+            lock_guard<mutex> guard(channel.channel_mutex);
+            drain_locked();
+            if (!batch.empty() || channel.closed)
+                return false;
+
+            waiter.handle = h;
+            channel.receivers.push(&waiter);
+            return true;
+        }
+
+        // Empty once the channel is closed and drained.
+        vector<T> await_resume() {
+            if (waiter.value) {
+                batch.push_back(std::move(*waiter.value));
+                lock_guard<mutex> guard(channel.channel_mutex);
+                drain_locked();
+            }
+            return std::move(batch);
+        }
+    };
+
+    AsyncChannel(int cap, Executor& exec)
+        : buffer(new T[cap > 0 ? cap : 1]), capacity(cap), buffer_head(0), buffer_count(0),
+          closed(false), executor(exec) {}
+
+    ~AsyncChannel() { delete[] buffer; }
+
+    SendAwaiter send(T value) { return SendAwaiter(*this, std::move(value)); }
+    ReceiveAwaiter receive() { return ReceiveAwaiter(*this); }
+    ReceiveManyAwaiter receive_many(int max_count) { return ReceiveManyAwaiter(*this, max_count); }
+
+    // Wakes every blocked sender (their send fails) and receiver (they get
+    // nothing). Values already buffered can still be received.
+    void close() {
+        lock_guard<mutex> guard(channel_mutex);
+        closed = true;
+        while (!senders.empty()) {
+            Waiter* sender = senders.pop();
+            sender->ok = false;
+            executor.schedule(sender->handle);
+        }
+        while (!receivers.empty()) {
+            Waiter* receiver = receivers.pop();
+            executor.schedule(receiver->handle);
+        }
+    }
+
+    int size() {
+        lock_guard<mutex> guard(channel_mutex);
+        return buffer_count;
+    }
+};
+
+Task produce(AsyncChannel<int>& out, int count) {
+    for (int i = 1; i <= count; ++i)
+        co_await out.send(i);
+    out.close();
+}
+
+Task double_values(AsyncChannel<int>& in, AsyncChannel<int>& out) {
+    while (optional<int> value = co_await in.receive())
+        co_await out.send(*value * 2);
+    out.close();
+}
+
+Task consume(AsyncChannel<int>& in, long long& sum) {
+    while (true) {
+        vector<int> batch = co_await in.receive_many(64);
+        if (batch.empty()) break;
+        for (int n : batch)
+            sum += n;
+    }
+}
+
+Task print_values(AsyncChannel<int>& in) {
+    while (optional<int> value = co_await in.receive())
+        cout << "Received " << *value << endl;
+    cout << "Channel closed.\n";
+}
+
+int main() {
+    {
+        SingleThreadExecutor executor;
+        AsyncChannel<int> channel(2, executor);
+
+        cout << "Sending 1..5 through a channel of capacity 2:\n";
+        executor.spawn(produce(channel, 5));
+        executor.spawn(print_values(channel));
+        executor.run();
+    }
+
+    {
+        ThreadPoolExecutor executor;
+        AsyncChannel<int> silent(1, executor);
+
+        executor.spawn(print_values(silent));
+        int suspended = executor.run(2);
+        cout << "\nReceiver on a channel nobody sends to: run() returned with "
+             << suspended << " task suspended\n";
+        silent.close();
+        suspended = executor.run(2);
+        cout << "After close() and run() again: " << suspended << " suspended\n";
+    }
+
+    const int N = 1000000;
+    const int HOPS = 2;
+    long long expected = (long long)N * (N + 1);
+
+    {
+        SingleThreadExecutor executor;
+        AsyncChannel<int> first(64, executor);
+        AsyncChannel<int> second(64, executor);
+        long long sum = 0;
+
+        auto start = chrono::steady_clock::now();
+        executor.spawn(produce(first, N));
+        executor.spawn(double_values(first, second));
+        executor.spawn(consume(second, sum));
+        executor.run();
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+        cout << "\nSingle-threaded pipeline, " << N << " values: sum "
+             << (sum == expected ? "ok" : "WRONG") << ", " << ns / N / HOPS << " ns per hop\n";
+    }
+
+    {
+        ThreadPoolExecutor executor;
+        AsyncChannel<int> first(64, executor);
+        AsyncChannel<int> second(64, executor);
+        long long sum = 0;
+
+        auto start = chrono::steady_clock::now();
+        executor.spawn(produce(first, N));
+        executor.spawn(double_values(first, second));
+        executor.spawn(consume(second, sum));
+        executor.run(4);
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+        cout << "Thread-pool pipeline (4 workers), " << N << " values: sum "
+             << (sum == expected ? "ok" : "WRONG") << ", " << ns / N / HOPS << " ns per hop\n";
+    }
+
+    cout << "\nProgram finished successfully.\n";
+
+    return 0;
+}
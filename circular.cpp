@@ -1,14 +1,133 @@
 #include <iostream>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <optional>
+#include <unistd.h>
 using namespace std;
 
+// Cold and out of line, as in singly.cpp; -DNO_ERROR_LOG compiles it out.
+[[gnu::cold, gnu::noinline]] void log_error([[maybe_unused]] const char* msg) {
+#ifndef NO_ERROR_LOG
+    cerr << msg;
+#endif
+}
+
+[[gnu::cold, gnu::noinline]] void log_index_error([[maybe_unused]] int max_index) {
+#ifndef NO_ERROR_LOG
+    cerr << "Invalid index! Must be between 0 and " << max_index << ".\n";
+#endif
+}
+
+enum DumpFormat { DUMP_TEXT, DUMP_CSV, DUMP_BINARY };
+
+// Formats values with to_chars into one large buffer and hands it to write()
+// in big pieces, instead of one operator<< per element like display().
+class DumpWriter {
+private:
+    static const int BUFFER_SIZE = 1 << 16;
+    char buffer[BUFFER_SIZE];
+    int used;
+    int fd;
+    DumpFormat format;
+    const char* separator;
+    bool first_item;
+    bool failed;
+
+    // Retries partial writes and EINTR. Any other error, or a write that makes
+    // no progress, marks the writer failed and drops everything after it.
+    void flush() {
+        int done = 0;
+        while (done < used && !failed) {
+            ssize_t n = write(fd, buffer + done, used - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) failed = true;
+            else done += (int)n;
+        }
+        used = 0;
+    }
+
+    void put(const char* s, int len) {
+        if (used + len > BUFFER_SIZE) flush();
+        memcpy(buffer + used, s, len);
+        used += len;
+    }
+
+    void put(const char* s) { put(s, (int)strlen(s)); }
+
+    void next_item() {
+        if (!first_item) put(separator);
+        first_item = false;
+    }
+
+public:
+    DumpWriter(int out_fd, DumpFormat fmt)
+        : used(0), fd(out_fd), format(fmt), separator(","), first_item(true), failed(false) {
+        if (fd == STDOUT_FILENO) cout.flush();   // keep ordering with earlier cout output
+    }
+
+    ~DumpWriter() { flush(); }
+
+    // Writes out what is buffered; false if any of the output was lost.
+    bool finish() {
+        flush();
+        return !failed;
+    }
+
+    void text(const char* s) {
+        if (format == DUMP_TEXT) put(s);
+    }
+
+    void text_value(int n) {
+        if (format != DUMP_TEXT) return;
+        if (used + 11 > BUFFER_SIZE) flush();
+        used = (int)(to_chars(buffer + used, buffer + BUFFER_SIZE, n).ptr - buffer);
+    }
+
+    void open(const char* prefix, const char* text_separator) {
+        if (format == DUMP_TEXT) separator = text_separator;
+        text(prefix);
+    }
+
+    void value(int n) {
+        if (format == DUMP_BINARY) {
+            put((const char*)&n, (int)sizeof(n));
+            return;
+        }
+        next_item();
+        if (used + 11 > BUFFER_SIZE) flush();
+        used = (int)(to_chars(buffer + used, buffer + BUFFER_SIZE, n).ptr - buffer);
+    }
+
+    // Marks values cut off by a first/last N limit.
+    void omitted() {
+        if (format != DUMP_TEXT) return;
+        next_item();
+        put("...");
+    }
+
+    void close(const char* suffix) {
+        if (format == DUMP_TEXT) put(suffix);
+        else if (format == DUMP_CSV) put("\n");
+    }
+};
+
+// Flushes a dump and reports a write that did not go through.
+bool finish_dump(DumpWriter& out) {
+    if (out.finish()) return true;
+    log_error("Dump failed! Could not write to the file descriptor.\n");
+    return false;
+}
+
 class Node {
 private:
     int value;
+    int weight;         // round-robin share; fits in the padding before next_node
     Node* next_node;
 
 public:
-    Node(int val = 0, Node* next = nullptr)
-        : value(val), next_node(next) {}
+    Node(int val = 0, Node* next = nullptr, int w = 1)
+        : value(val), weight(w), next_node(next) {}
 
     int retrieve() const { return value; }
     Node* next() const { return next_node; }
@@ -20,9 +139,57 @@ public:
 class CList {
 private:
     Node* list_tail; 
+    Node* cursor_prev;  // node before the cursor, so remove_current() is O(1)
+    int list_size;
+    int served;         // turns the current node has had in next_weighted()
+
+    // Bulk operations unlink first and free everything here in one go.
+    static void free_chain(Node* ptr) {
+        while (ptr != nullptr) {
+            Node* temp = ptr;
+            ptr = ptr->next();
+            delete temp;
+        }
+    }
+
+    // Unlinks the node after prev, keeping tail and cursor valid.
+    Node* unlink_after(Node* prev) {
+        Node* ptr = prev->next();
+        if (cursor_prev->next() == ptr)
+            served = 0;
+
+        if (ptr == prev) {
+            list_tail = nullptr;
+            cursor_prev = nullptr;
+        }
+        else {
+            prev->set_next(ptr->next());
+            if (ptr == list_tail)
+                list_tail = prev;
+            if (ptr == cursor_prev)
+                cursor_prev = prev;
+        }
+        --list_size;
+        return ptr;
+    }
+
+    void link_end(Node* new_node) {
+        if (empty()) {
+            new_node->set_next(new_node);
+            cursor_prev = new_node;
+        }
+        else {
+            new_node->set_next(list_tail->next());
+            list_tail->set_next(new_node);
+            if (cursor_prev == list_tail)
+                cursor_prev = new_node;
+        }
+        list_tail = new_node;
+        ++list_size;
+    }
 
 public:
-    CList() : list_tail(nullptr) {}
+    CList() : list_tail(nullptr), cursor_prev(nullptr), list_size(0), served(0) {}
 
     ~CList() {
         while (!empty())
@@ -42,20 +209,39 @@ public:
         return list_tail;
     }
 
+    // Unchecked variants: the caller guarantees the list is not empty.
+    int front_unchecked() const {
+        return head()->retrieve();
+    }
+
+    int end_unchecked() const {
+        return tail()->retrieve();
+    }
+
     int front() const {
         if (empty()) {
-            cerr << "List is empty! Cannot access front element.\n";
+            log_error("List is empty! Cannot access front element.\n");
             return -1;
         }
-        return head()->retrieve(); 
+        return front_unchecked(); 
     }
 
     int end() const {
         if (empty()) {
-            cerr << "List is empty! Cannot access end element.\n";
+            log_error("List is empty! Cannot access end element.\n");
             return -1;
         }
-        return tail()->retrieve();
+        return end_unchecked();
+    }
+
+    optional<int> try_front() const {
+        if (empty()) return nullopt;
+        return front_unchecked();
+    }
+
+    optional<int> try_end() const {
+        if (empty()) return nullopt;
+        return end_unchecked();
     }
 
     void push_front(int n) {
@@ -63,12 +249,16 @@ public:
             Node* new_node = new Node(n);
             new_node->set_next(new_node); 
             list_tail = new_node;
+            cursor_prev = new_node;
         } 
         else {
             Node* old_head = list_tail->next();
             Node* new_node = new Node(n, old_head);
             list_tail->set_next(new_node);
+            if (cursor_prev == list_tail)
+                cursor_prev = new_node;
         }
+        ++list_size;
     }
 
     void push_end(int n) {
@@ -79,25 +269,37 @@ public:
             Node* old_head = list_tail->next();
             Node* new_node = new Node(n, old_head);
             list_tail->set_next(new_node);
+            if (cursor_prev == list_tail)
+                cursor_prev = new_node;
             list_tail = new_node;
+            ++list_size;
         }
     }
 
     void push_between(int index, int n) {
-        if (empty()) {
-            cerr << "Cannot insert in empty list! Use push_front first.\n";
+        int size_val = size();
+        if (size_val == 0) {
+            log_error("Cannot insert in empty list! Use push_front first.\n");
             return;
         }
 
+        if (!try_push_between(index, n))
+            log_index_error(size_val - 1);
+    }
+
+    bool try_push_between(int index, int n) {
+        if (empty()) {
+            return false;
+        }
+
         int size_val = size();
         if (index < 0 || index >= size_val) {
-            cerr << "Invalid index! Must be between 0 and " << (size_val - 1) << ".\n";
-            return;
+            return false;
         }
 
         if (index == 0) {
             push_front(n);
-            return;
+            return true;
         }
 
         Node* ptr = head();
@@ -107,41 +309,44 @@ public:
 
         Node* new_node = new Node(n, ptr->next());
         ptr->set_next(new_node);
+        if (cursor_prev == ptr)
+            cursor_prev = new_node;
+        ++list_size;
+        return true;
     }
 
-    int pop_front() {
-        if (empty()) {
-            cerr << "List is empty! Cannot pop front.\n";
-            return -1;
-        }
-
+    int pop_front_unchecked() {
         Node* old_head = list_tail->next();
         int value = old_head->retrieve();
+        if (cursor_prev->next() == old_head)
+            served = 0;
 
         if (old_head == list_tail) {
             // Case 1: Only one node
             delete old_head;
             list_tail = nullptr;
+            cursor_prev = nullptr;
         } 
         else {
             list_tail->set_next(old_head->next());
+            if (cursor_prev == old_head)
+                cursor_prev = list_tail;
             delete old_head;
         }
+        --list_size;
         return value;
     }
 
-    int pop_end() {
-        if (empty()) {
-            cerr << "List is empty! Cannot pop end.\n";
-            return -1;
-        }
-
+    int pop_end_unchecked() {
         Node* old_tail = list_tail;
         int value = old_tail->retrieve();
+        if (cursor_prev->next() == old_tail)
+            served = 0;
 
         if (list_tail->next() == list_tail) {
             delete old_tail;
             list_tail = nullptr;
+            cursor_prev = nullptr;
         } 
         else {
             Node* ptr = list_tail->next();
@@ -149,30 +354,70 @@ public:
                 ptr = ptr->next();
             }
             ptr->set_next(list_tail->next()); 
+            if (cursor_prev == old_tail)
+                cursor_prev = ptr;
             list_tail = ptr;                  
             delete old_tail;
         }
+        --list_size;
         return value;
     }
 
-    int erase(int index) {
+    int pop_front() {
+        if (empty()) {
+            log_error("List is empty! Cannot pop front.\n");
+            return -1;
+        }
+        return pop_front_unchecked();
+    }
+
+    int pop_end() {
         if (empty()) {
-            cerr << "List is empty! Cannot erase.\n";
+            log_error("List is empty! Cannot pop end.\n");
             return -1;
         }
+        return pop_end_unchecked();
+    }
 
+    optional<int> try_pop_front() {
+        if (empty()) return nullopt;
+        return pop_front_unchecked();
+    }
+
+    optional<int> try_pop_end() {
+        if (empty()) return nullopt;
+        return pop_end_unchecked();
+    }
+
+    int erase(int index) {
         int size_val = size();
-        if (index < 0 || index >= size_val) {
-            cerr << "Invalid index! Must be between 0 and " << (size_val - 1) << ".\n";
+        if (size_val == 0) {
+            log_error("List is empty! Cannot erase.\n");
             return -1;
         }
+
+        optional<int> value = try_erase(index);
+        if (!value) {
+            log_index_error(size_val - 1);
+            return -1;
+        }
+        return *value;
+    }
+
+    optional<int> try_erase(int index) {
+        if (empty()) return nullopt;
+
+        int size_val = size();
+        if (index < 0 || index >= size_val) {
+            return nullopt;
+        }
         
         if (index == 0) {
-            return pop_front();
+            return pop_front_unchecked();
         }
         
         if (index == size_val - 1) {
-            return pop_end();
+            return pop_end_unchecked();
         }
         
         Node* ptr = head();
@@ -184,11 +429,136 @@ public:
         int value = to_delete->retrieve();
 
         ptr->set_next(to_delete->next());
+        if (cursor_prev == ptr)
+            served = 0;
+        if (cursor_prev == to_delete)
+            cursor_prev = ptr;
         delete to_delete;
+        --list_size;
 
         return value;
     }
 
+    // Removes every value for which pred is true in one trip around the list.
+    template <typename Pred>
+    int erase_if(Pred pred) {
+        int count_removed = 0;
+        Node* garbage = nullptr;
+        Node* prev = list_tail;
+        int n = list_size;
+
+        for (int i = 0; i < n; ++i) {
+            if (pred(prev->next()->retrieve())) {
+                Node* ptr = unlink_after(prev);
+                ptr->set_next(garbage);
+                garbage = ptr;
+                ++count_removed;
+            } else {
+                prev = prev->next();
+            }
+        }
+
+        free_chain(garbage);
+        return count_removed;
+    }
+
+    // Collapses runs of equal neighbouring values, head to tail, to one node.
+    int unique() {
+        if (empty()) return 0;
+
+        int count_removed = 0;
+        Node* garbage = nullptr;
+        Node* prev = head();
+        int n = list_size;
+
+        for (int i = 1; i < n; ++i) {
+            if (prev->next()->retrieve() == prev->retrieve()) {
+                Node* ptr = unlink_after(prev);
+                ptr->set_next(garbage);
+                garbage = ptr;
+                ++count_removed;
+            } else {
+                prev = prev->next();
+            }
+        }
+
+        free_chain(garbage);
+        return count_removed;
+    }
+
+    // Moves the nodes for which pred is true, in order, to the end of matching;
+    // the rest stay here. Nodes are relinked, never copied.
+    template <typename Pred>
+    void partition(Pred pred, CList& matching) {
+        if (&matching == this) return;
+
+        Node* prev = list_tail;
+        int n = list_size;
+
+        for (int i = 0; i < n; ++i) {
+            if (pred(prev->next()->retrieve()))
+                matching.link_end(unlink_after(prev));
+            else
+                prev = prev->next();
+        }
+    }
+
+    // Removes positions [first, last) counted from the head; a range running
+    // past the end stops there, as in List and DList.
+    int remove_range(int first, int last) {
+        if (first < 0 || last < first) {
+            log_error("Invalid range! Need 0 <= first <= last.\n");
+            return 0;
+        }
+        if (last > list_size) last = list_size;
+        if (first >= last) return 0;
+
+        Node* garbage = nullptr;
+        Node* prev = list_tail;
+        for (int i = 0; i < first; ++i)
+            prev = prev->next();
+
+        for (int i = first; i < last; ++i) {
+            Node* ptr = unlink_after(prev);
+            ptr->set_next(garbage);
+            garbage = ptr;
+        }
+
+        free_chain(garbage);
+        return last - first;
+    }
+
+    // Buffered alternative to display() for large lists. DUMP_TEXT matches the
+    // display() format, DUMP_CSV writes comma-separated values and DUMP_BINARY
+    // the raw ints. A non-negative limit keeps only the first limit values, or
+    // the last ones when from_back is set. Returns false, after logging it,
+    // if the output could not be written.
+    bool dump(int fd, DumpFormat format = DUMP_TEXT, int limit = -1, bool from_back = false) const {
+        DumpWriter out(fd, format);
+        if (empty()) {
+            out.text("List is empty.\n");
+            return finish_dump(out);
+        }
+
+        int skip = (limit >= 0 && from_back && limit < list_size) ? list_size - limit : 0;
+        int shown_max = (limit >= 0 && limit < list_size) ? limit : list_size;
+        Node* ptr = head();
+        for (int i = 0; i < skip; ++i)
+            ptr = ptr->next();
+
+        out.open("Head -> ", " -> ");
+        if (skip > 0) out.omitted();
+        for (int shown = 0; shown < shown_max; ++shown) {
+            out.value(ptr->retrieve());
+            ptr = ptr->next();
+        }
+        if (skip + shown_max < list_size) out.omitted();
+        out.close(" -> (Back to Head)\n(Tail is: ");
+        out.text_value(list_tail->retrieve());
+        out.text(")\n");
+        return finish_dump(out);
+    }
+
     void display() const {
         if (empty()) {
             cout << "List is empty.\n";
@@ -207,16 +577,108 @@ public:
     }
 
     int size() const {
-        if (empty()) return 0;
+        return list_size;
+    }
 
-        int count = 0;
-        Node* ptr = head();
-        do {
-            ++count;
-            ptr = ptr->next();
-        } while (ptr != head());
-        
-        return count;
+    // Round-robin cursor. It starts on the head, follows the node it points at
+    // through other inserts and erases, and never allocates while rotating.
+    Node* cursor() const {
+        if (empty()) return nullptr;
+        return cursor_prev->next();
+    }
+
+    int current() const {
+        if (empty()) {
+            log_error("List is empty! Cannot access current element.\n");
+            return -1;
+        }
+        return cursor_prev->next()->retrieve();
+    }
+
+    void advance() {
+        if (empty()) return;
+        cursor_prev = cursor_prev->next();
+        served = 0;
+    }
+
+    void rotate(int k) {
+        if (empty()) return;
+        k %= list_size;
+        if (k < 0) k += list_size;
+        for (int i = 0; i < k; ++i)
+            cursor_prev = cursor_prev->next();
+        served = 0;
+    }
+
+    // Unlinks the current node; the cursor moves on to the node that followed it.
+    int remove_current() {
+        if (empty()) {
+            log_error("List is empty! Cannot remove current element.\n");
+            return -1;
+        }
+
+        Node* to_delete = cursor_prev->next();
+        int value = to_delete->retrieve();
+
+        if (to_delete == cursor_prev) {
+            list_tail = nullptr;
+            cursor_prev = nullptr;
+        }
+        else {
+            cursor_prev->set_next(to_delete->next());
+            if (to_delete == list_tail)
+                list_tail = cursor_prev;
+        }
+
+        delete to_delete;
+        --list_size;
+        served = 0;
+        return value;
+    }
+
+    void insert_after_current(int n, int weight = 1) {
+        if (weight < 1) weight = 1;
+        if (empty()) {
+            push_front(n);
+            list_tail->weight = weight;
+            return;
+        }
+
+        Node* current_node = cursor_prev->next();
+        Node* new_node = new Node(n, current_node->next(), weight);
+        current_node->set_next(new_node);
+        if (current_node == list_tail)
+            list_tail = new_node;
+        // With one node, current_node was also cursor_prev; the new node is
+        // now the one before it.
+        if (cursor_prev == current_node)
+            cursor_prev = new_node;
+        ++list_size;
+    }
+
+    void set_current_weight(int weight) {
+        if (empty()) {
+            log_error("List is empty! Cannot set weight.\n");
+            return;
+        }
+        cursor_prev->next()->weight = (weight < 1) ? 1 : weight;
+    }
+
+    // Weighted round-robin: each node is returned weight times in a row before
+    // the cursor moves on.
+    int next_weighted() {
+        if (empty()) {
+            log_error("List is empty! Cannot schedule.\n");
+            return -1;
+        }
+
+        Node* current_node = cursor_prev->next();
+        int value = current_node->retrieve();
+        if (++served >= current_node->weight) {
+            cursor_prev = current_node;
+            served = 0;
+        }
+        return value;
     }
 };
 
@@ -253,6 +715,47 @@ int main() {
     cout << "\nPopping end: " << lst.pop_end() << endl; 
     lst.display();
 
+    cout << "\nRound-robin over 1, 2, 3 with weights 1, 2, 1:\n";
+    lst.push_end(1);
+    lst.push_end(2);
+    lst.push_end(3);
+    lst.advance();
+    lst.set_current_weight(2);
+    lst.rotate(2);
+    for (int i = 0; i < 8; ++i)
+        cout << lst.next_weighted() << " ";
+    cout << endl;
+
+    cout << "Current: " << lst.current() << ", removing it: " << lst.remove_current() << endl;
+    cout << "Inserting 4 after current (" << lst.current() << "):\n";
+    lst.insert_after_current(4);
+    lst.display();
+    cout << "Size: " << lst.size() << endl;
+    cout << "As CSV: ";
+    lst.dump(STDOUT_FILENO, DUMP_CSV);
+
+    while (!lst.empty())
+        lst.remove_current();
+
+    cout << "\nBulk operations on 1, 1, 2, 3, 3, 4, 5, 6:\n";
+    int values[] = { 1, 1, 2, 3, 3, 4, 5, 6 };
+    for (int n : values)
+        lst.push_end(n);
+    cout << "unique() removed " << lst.unique() << endl;
+    CList evens;
+    lst.partition([](int n) { return n % 2 == 0; }, evens);
+    cout << "partition(even) left:\n";
+    lst.display();
+    cout << "and moved:\n";
+    evens.display();
+    cout << "remove_range(0, 2) removed " << evens.remove_range(0, 2) << endl;
+    evens.display();
+    cout << "erase_if(> 0) removed " << lst.erase_if([](int n) { return n > 0; }) << endl;
+    lst.display();
+
+    cout << "\ntry_pop_front on empty list has value? " << (lst.try_pop_front() ? "Yes" : "No") << endl;
+    cout << "try_erase(0) on empty list has value? " << (lst.try_erase(0) ? "Yes" : "No") << endl;
+
     cout << "\nProgram finished successfully.\n";
 
     return 0;
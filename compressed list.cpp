@@ -0,0 +1,477 @@
+#include <iostream>
+#include <chrono>
+using namespace std;
+
+// Cold error path, as in singly.cpp; -DNO_ERROR_LOG compiles it out.
+[[gnu::cold, gnu::noinline]] void log_error([[maybe_unused]] const char* msg) {
+#ifndef NO_ERROR_LOG
+    cerr << msg;
+#endif
+}
+
+const int BLOCK_CAPACITY = 128;   // values stored per block
+const int MAX_VARINT_BYTES = 5;   // a zig-zag delta between two ints never needs more
+
+// Deltas are zig-zag mapped so small negative steps (nearly sorted data) stay small.
+unsigned long long zigzag_encode(long long delta) {
+    return ((unsigned long long)delta << 1) ^ (unsigned long long)(delta >> 63);
+}
+
+long long zigzag_decode(unsigned long long n) {
+    return (long long)(n >> 1) ^ -(long long)(n & 1);
+}
+
+int write_varint(unsigned char* out, unsigned long long n) {
+    int len = 0;
+    while (n >= 0x80) {
+        out[len++] = (unsigned char)(n | 0x80);
+        n >>= 7;
+    }
+    out[len++] = (unsigned char)n;
+    return len;
+}
+
+class Block {
+private:
+    int first_value;      // stored raw, every later value is a delta
+    int last_value;
+    int min_value;        // skip header: count/contains ignore blocks
+    int max_value;        // whose range cannot hold the value
+    int value_count;
+    int byte_count;
+    int byte_capacity;
+    unsigned char* bytes;
+    Block* next_block;
+
+    void reserve(int needed) {
+        if (needed <= byte_capacity) return;
+        int new_capacity = (byte_capacity == 0) ? 16 : byte_capacity * 2;
+        while (new_capacity < needed)
+            new_capacity *= 2;
+        unsigned char* new_bytes = new unsigned char[new_capacity];
+
+        for (int i = 0; i < byte_count; ++i) {
+            new_bytes[i] = bytes[i];
+        }
+
+        delete[] bytes;
+        bytes = new_bytes;
+        byte_capacity = new_capacity;
+    }
+
+public:
+    Block(int val = 0, Block* next = nullptr)
+        : first_value(val), last_value(val), min_value(val), max_value(val),
+          value_count(1), byte_count(0), byte_capacity(0), bytes(nullptr),
+          next_block(next) {}
+
+    ~Block() { delete[] bytes; }
+
+    int count() const { return value_count; }
+    bool full() const { return value_count == BLOCK_CAPACITY; }
+    int memory_bytes() const { return (int)sizeof(Block) + byte_capacity; }
+    Block* next() const { return next_block; }
+
+    void append(int n) {
+        reserve(byte_count + MAX_VARINT_BYTES);
+        byte_count += write_varint(bytes + byte_count, zigzag_encode((long long)n - last_value));
+        last_value = n;
+        if (n < min_value) min_value = n;
+        if (n > max_value) max_value = n;
+        ++value_count;
+    }
+
+    // Release the slack left by append's doubling once no more values will arrive.
+    void shrink() {
+        if (byte_capacity == byte_count) return;
+        unsigned char* new_bytes = (byte_count == 0) ? nullptr : new unsigned char[byte_count];
+
+        for (int i = 0; i < byte_count; ++i) {
+            new_bytes[i] = bytes[i];
+        }
+
+        delete[] bytes;
+        bytes = new_bytes;
+        byte_capacity = byte_count;
+    }
+
+    int decode(int* out) const {
+        long long prev = first_value;
+        out[0] = first_value;
+        const unsigned char* ptr = bytes;
+
+        for (int i = 1; i < value_count; ++i) {
+            unsigned long long n = *ptr++;
+            if (n >= 0x80) {
+                n &= 0x7f;
+                int shift = 7;
+                unsigned long long b;
+                do {
+                    b = *ptr++;
+                    n |= (b & 0x7f) << shift;
+                    shift += 7;
+                } while (b >= 0x80);
+            }
+            prev += zigzag_decode(n);
+            out[i] = (int)prev;
+        }
+        return value_count;
+    }
+
+    // Rebuild the whole block from plain values (used by ordered insert and split).
+    void encode(const int* values, int n) {
+        first_value = last_value = min_value = max_value = values[0];
+        value_count = 1;
+        byte_count = 0;
+        for (int i = 1; i < n; ++i)
+            append(values[i]);
+        shrink();
+    }
+
+    friend class CompressedList;
+};
+
+class CompressedList {
+private:
+    Block* list_head;
+    Block* list_tail;
+    int value_count;
+    int block_count;
+    bool sorted;        // true while every append kept values non-decreasing
+    Block** block_index;   // block_index[i] is the i-th block, for binary search
+    int index_capacity;
+
+    void index_insert(int pos, Block* block) {
+        if (block_count == index_capacity) {
+            int new_capacity = (index_capacity == 0) ? 16 : index_capacity * 2;
+            Block** new_index = new Block*[new_capacity];
+
+            for (int i = 0; i < block_count; ++i) {
+                new_index[i] = block_index[i];
+            }
+
+            delete[] block_index;
+            block_index = new_index;
+            index_capacity = new_capacity;
+        }
+
+        for (int i = block_count; i > pos; --i) {
+            block_index[i] = block_index[i - 1];
+        }
+        block_index[pos] = block;
+        ++block_count;
+    }
+
+    // Position of the first block whose max_value reaches n. Only meaningful
+    // while sorted: the blocks' ranges are then in order, so n can only sit
+    // in that block (or, for repeats of n, in the ones right after it).
+    int first_block_reaching(int n) const {
+        int lo = 0;
+        int hi = block_count;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (block_index[mid]->max_value < n)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+public:
+    CompressedList()
+        : list_head(nullptr), list_tail(nullptr), value_count(0), block_count(0), sorted(true),
+          block_index(nullptr), index_capacity(0) {}
+
+    ~CompressedList() {
+        while (list_head != nullptr) {
+            Block* temp = list_head;
+            list_head = list_head->next();
+            delete temp;
+        }
+        delete[] block_index;
+    }
+
+    bool empty() const {
+        return (list_head == nullptr);
+    }
+
+    int size() const {
+        return value_count;
+    }
+
+    int blocks() const {
+        return block_count;
+    }
+
+    bool is_sorted() const {
+        return sorted;
+    }
+
+    int front() const {
+        if (empty()) {
+            log_error("List is empty! Cannot access front element.\n");
+            return -1;
+        }
+        return list_head->first_value;
+    }
+
+    int end() const {
+        if (empty()) {
+            log_error("List is empty! Cannot access end element.\n");
+            return -1;
+        }
+        return list_tail->last_value;
+    }
+
+    int memory_bytes() const {
+        int total = (int)sizeof(CompressedList) + index_capacity * (int)sizeof(Block*);
+        for (Block* ptr = list_head; ptr != nullptr; ptr = ptr->next())
+            total += ptr->memory_bytes();
+        return total;
+    }
+
+    void push_end(int n) {
+        if (!empty() && n < list_tail->last_value)
+            sorted = false;
+
+        if (empty() || list_tail->full()) {
+            Block* new_block = new Block(n);
+            if (empty()) {
+                list_head = new_block;
+            }
+            else {
+                list_tail->shrink();
+                list_tail->next_block = new_block;
+            }
+            list_tail = new_block;
+            index_insert(block_count, new_block);
+        }
+        else {
+            list_tail->append(n);
+        }
+        ++value_count;
+    }
+
+    // Insert keeping ascending order; only the block that receives n is re-encoded.
+    void insert(int n) {
+        if (empty() || n >= list_tail->last_value) {
+            push_end(n);
+            return;
+        }
+
+        if (!sorted) {
+            log_error("List is not sorted! Use push_end instead.\n");
+            return;
+        }
+
+        int block_pos = first_block_reaching(n);
+        Block* ptr = block_index[block_pos];
+
+        int values[BLOCK_CAPACITY + 1];
+        int len = ptr->decode(values);
+
+        int pos = len;
+        while (pos > 0 && values[pos - 1] > n) {
+            values[pos] = values[pos - 1];
+            --pos;
+        }
+        values[pos] = n;
+        ++len;
+
+        if (len <= BLOCK_CAPACITY) {
+            ptr->encode(values, len);
+        }
+        else {
+            int half = len / 2;
+            Block* new_block = new Block(values[half], ptr->next());
+            new_block->encode(values + half, len - half);
+            ptr->encode(values, half);
+            ptr->next_block = new_block;
+            if (ptr == list_tail)
+                list_tail = new_block;
+            index_insert(block_pos + 1, new_block);
+        }
+        ++value_count;
+    }
+
+    int count(int n) const {
+        int node_count = 0;
+        int values[BLOCK_CAPACITY];
+
+        Block* ptr = list_head;
+        if (sorted) {
+            int pos = first_block_reaching(n);
+            ptr = (pos < block_count) ? block_index[pos] : nullptr;
+        }
+
+        for (; ptr != nullptr; ptr = ptr->next()) {
+            if (sorted && ptr->min_value > n)
+                break;
+            if (n < ptr->min_value || n > ptr->max_value)
+                continue;
+
+            int len = ptr->decode(values);
+            for (int i = 0; i < len; ++i) {
+                if (values[i] == n)
+                    ++node_count;
+            }
+        }
+        return node_count;
+    }
+
+    // Sorted lists binary-search the block directory and decode one block;
+    // unsorted ones still visit every block but skip those whose min/max
+    // range cannot hold n.
+    bool contains(int n) const {
+        int values[BLOCK_CAPACITY];
+
+        if (sorted) {
+            int pos = first_block_reaching(n);
+            if (pos == block_count || block_index[pos]->min_value > n)
+                return false;
+
+            int len = block_index[pos]->decode(values);
+            for (int i = 0; i < len && values[i] <= n; ++i) {
+                if (values[i] == n)
+                    return true;
+            }
+            return false;
+        }
+
+        for (Block* ptr = list_head; ptr != nullptr; ptr = ptr->next()) {
+            if (n < ptr->min_value || n > ptr->max_value)
+                continue;
+
+            int len = ptr->decode(values);
+            for (int i = 0; i < len; ++i) {
+                if (values[i] == n)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename Func>
+    void for_each(Func f) const {
+        int values[BLOCK_CAPACITY];
+
+        for (Block* ptr = list_head; ptr != nullptr; ptr = ptr->next()) {
+            int len = ptr->decode(values);
+            for (int i = 0; i < len; ++i)
+                f(values[i]);
+        }
+    }
+
+    void display() const {
+        if (empty()) {
+            cout << "List is empty.\n";
+            return;
+        }
+
+        for_each([](int n) { cout << n << " -> "; });
+        cout << "nullptr\n";
+    }
+};
+
+// Plain singly-linked node used as the baseline in the comparison below.
+class Node {
+private:
+    int value;
+    Node* next_node;
+
+public:
+    Node(int val = 0, Node* next = nullptr)
+        : value(val), next_node(next) {}
+
+    int retrieve() const { return value; }
+    Node* next() const { return next_node; }
+    void set_next(Node* next) { next_node = next; }
+};
+
+int main() {
+    CompressedList lst;
+
+    cout << "Appending 10, 20, 30, 40, 50:\n";
+    lst.push_end(10);
+    lst.push_end(20);
+    lst.push_end(30);
+    lst.push_end(40);
+    lst.push_end(50);
+    lst.display();
+
+    cout << "\nOrdered insert of 25, 5, 60, 25:\n";
+    lst.insert(25);
+    lst.insert(5);
+    lst.insert(60);
+    lst.insert(25);
+    lst.display();
+
+    cout << "\nFront element: " << lst.front() << endl;
+    cout << "End element: " << lst.end() << endl;
+    cout << "Size of list: " << lst.size() << endl;
+    cout << "Counting how many times 25 appears: " << lst.count(25) << endl;
+    cout << "Contains 35? " << (lst.contains(35) ? "Yes" : "No") << endl;
+
+    const int N = 1000000;
+    cout << "\nBuilding " << N << " sorted ids in both containers:\n";
+
+    CompressedList ids;
+    Node* list_head = nullptr;
+    Node* list_tail = nullptr;
+    unsigned int seed = 12345;
+    int id = 0;
+    for (int i = 0; i < N; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        id += 1 + (int)((seed >> 16) % 16);
+        ids.push_end(id);
+
+        Node* new_node = new Node(id);
+        if (list_head == nullptr) list_head = new_node;
+        else list_tail->set_next(new_node);
+        list_tail = new_node;
+    }
+
+    long long list_bytes = (long long)N * sizeof(Node);
+    long long compressed_bytes = ids.memory_bytes();
+    cout << "List bytes (payload + pointers): " << list_bytes << endl;
+    cout << "CompressedList bytes: " << compressed_bytes << " in " << ids.blocks() << " blocks\n";
+    cout << "Compression ratio: " << (double)list_bytes / compressed_bytes << "x\n";
+
+    const int SCANS = 20;
+    long long checksum = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (int s = 0; s < SCANS; ++s) {
+        for (Node* ptr = list_head; ptr != nullptr; ptr = ptr->next())
+            checksum += ptr->retrieve();
+    }
+    auto list_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (int s = 0; s < SCANS; ++s)
+        ids.for_each([&checksum](int n) { checksum -= n; });
+    auto compressed_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "Full scan, List: " << list_time / SCANS << " ms\n";
+    cout << "Full scan, CompressedList: " << compressed_time / SCANS << " ms\n";
+    cout << "Checksum (should be 0): " << checksum << endl;
+
+    start = chrono::steady_clock::now();
+    int hits = 0;
+    for (int s = 0; s < 1000; ++s)
+        hits += ids.contains(id / 1000 * s);
+    auto lookup_time = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    cout << "contains() with binary search over blocks: " << lookup_time / 1000 << " us per lookup ("
+         << hits << " hits)\n";
+
+    while (list_head != nullptr) {
+        Node* temp = list_head;
+        list_head = list_head->next();
+        delete temp;
+    }
+
+    cout << "\nProgram finished successfully.\n";
+
+    return 0;
+}
@@ -0,0 +1,382 @@
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+using namespace std;
+
+// Double-ended queue in a circular buffer. Capacity is always a power of two,
+// so wrapping an index is a single AND with mask instead of a division.
+class RingDeque {
+private:
+    int* data;
+    int capacity;
+    int mask;
+    int head_index;     // slot of the front element
+    int count;
+
+    // Doubles the buffer. The live range is [head_index, capacity) followed by
+    // [0, wrapped) at most, so it moves in at most two memcpy calls.
+    void resize() {
+        int new_capacity = (capacity == 0) ? 8 : capacity * 2;
+        int* new_data = new int[new_capacity];
+
+        int first_part = capacity - head_index;
+        if (first_part > count) first_part = count;
+        if (count > 0) {
+            memcpy(new_data, data + head_index, first_part * sizeof(int));
+            memcpy(new_data + first_part, data, (count - first_part) * sizeof(int));
+        }
+
+        delete[] data;
+        data = new_data;
+        capacity = new_capacity;
+        mask = new_capacity - 1;
+        head_index = 0;
+    }
+
+public:
+    RingDeque() : data(nullptr), capacity(0), mask(0), head_index(0), count(0) {}
+    ~RingDeque() { delete[] data; }
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+
+    void push_front(int n) {
+        if (count == capacity) {
+            resize();
+        }
+        head_index = (head_index - 1) & mask;
+        data[head_index] = n;
+        ++count;
+    }
+
+    void push_end(int n) {
+        if (count == capacity) {
+            resize();
+        }
+        data[(head_index + count) & mask] = n;
+        ++count;
+    }
+
+    // Unchecked variants: the caller guarantees the deque is not empty.
+    int pop_front_unchecked() {
+        int value = data[head_index];
+        head_index = (head_index + 1) & mask;
+        --count;
+        return value;
+    }
+
+    int pop_end_unchecked() {
+        --count;
+        return data[(head_index + count) & mask];
+    }
+
+    int pop_front() {
+        if (empty()) {
+            throw out_of_range("Pop front on empty deque");
+        }
+        return pop_front_unchecked();
+    }
+
+    int pop_end() {
+        if (empty()) {
+            throw out_of_range("Pop end on empty deque");
+        }
+        return pop_end_unchecked();
+    }
+
+    optional<int> try_pop_front() {
+        if (empty()) return nullopt;
+        return pop_front_unchecked();
+    }
+
+    optional<int> try_pop_end() {
+        if (empty()) return nullopt;
+        return pop_end_unchecked();
+    }
+
+    int front() const {
+        if (empty()) {
+            throw out_of_range("Front on empty deque");
+        }
+        return data[head_index];
+    }
+
+    int end() const {
+        if (empty()) {
+            throw out_of_range("End on empty deque");
+        }
+        return data[(head_index + count - 1) & mask];
+    }
+
+    // Random access from the front; operator[] skips the bounds check.
+    int& operator[](int index) { return data[(head_index + index) & mask]; }
+    int operator[](int index) const { return data[(head_index + index) & mask]; }
+
+    int at(int index) const {
+        if (index < 0 || index >= count) {
+            throw out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Appends n values with at most two memcpy calls.
+    void push_end(const int* values, int n) {
+        if (n <= 0) return;
+        while (capacity - count < n) {
+            resize();
+        }
+
+        int tail_index = (head_index + count) & mask;
+        int first_part = capacity - tail_index;
+        if (first_part > n) first_part = n;
+        memcpy(data + tail_index, values, first_part * sizeof(int));
+        memcpy(data, values + first_part, (n - first_part) * sizeof(int));
+        count += n;
+    }
+
+    // Removes up to n values from the front into out; returns how many.
+    int pop_front(int* out, int n) {
+        if (n > count) n = count;
+        if (n <= 0) return 0;
+
+        int first_part = capacity - head_index;
+        if (first_part > n) first_part = n;
+        memcpy(out, data + head_index, first_part * sizeof(int));
+        memcpy(out + first_part, data, (n - first_part) * sizeof(int));
+        head_index = (head_index + n) & mask;
+        count -= n;
+        return n;
+    }
+
+    void display() const {
+        if (empty()) {
+            cout << "Deque is empty.\n";
+            return;
+        }
+
+        cout << "FRONT -> ";
+        for (int i = 0; i < count; ++i) {
+            cout << (*this)[i] << " -> ";
+        }
+        cout << "END\n";
+    }
+};
+
+// Cut-down copies of CList and DList (queue operations only) for the
+// benchmarks below.
+class Node {
+private:
+    int value;
+    Node* next_node;
+
+public:
+    Node(int val = 0, Node* next = nullptr)
+        : value(val), next_node(next) {}
+
+    int retrieve() const { return value; }
+    Node* next() const { return next_node; }
+    void set_next(Node* next) { next_node = next; }
+};
+
+class CList {
+private:
+    Node* list_tail;
+
+public:
+    CList() : list_tail(nullptr) {}
+
+    ~CList() {
+        while (!empty())
+            pop_front();
+    }
+
+    bool empty() const { return list_tail == nullptr; }
+
+    void push_end(int n) {
+        if (empty()) {
+            list_tail = new Node(n);
+            list_tail->set_next(list_tail);
+        }
+        else {
+            Node* new_node = new Node(n, list_tail->next());
+            list_tail->set_next(new_node);
+            list_tail = new_node;
+        }
+    }
+
+    int pop_front() {
+        Node* old_head = list_tail->next();
+        int value = old_head->retrieve();
+        if (old_head == list_tail) list_tail = nullptr;
+        else list_tail->set_next(old_head->next());
+        delete old_head;
+        return value;
+    }
+
+    int pop_end() {
+        Node* old_tail = list_tail;
+        int value = old_tail->retrieve();
+        if (list_tail->next() == list_tail) {
+            list_tail = nullptr;
+        }
+        else {
+            Node* ptr = list_tail->next();
+            while (ptr->next() != list_tail)
+                ptr = ptr->next();
+            ptr->set_next(list_tail->next());
+            list_tail = ptr;
+        }
+        delete old_tail;
+        return value;
+    }
+};
+
+class DNode {
+private:
+    int value;
+    DNode* next_node;
+    DNode* prev_node;
+
+public:
+    DNode(int val = 0, DNode* next = nullptr, DNode* prev = nullptr)
+        : value(val), next_node(next), prev_node(prev) {}
+
+    int retrieve() const { return value; }
+    DNode* next() const { return next_node; }
+    DNode* prev() const { return prev_node; }
+    void set_next(DNode* next) { next_node = next; }
+    void set_prev(DNode* prev) { prev_node = prev; }
+};
+
+class DList {
+private:
+    DNode* list_head;
+    DNode* list_tail;
+
+public:
+    DList() : list_head(nullptr), list_tail(nullptr) {}
+
+    ~DList() {
+        while (!empty())
+            pop_front();
+    }
+
+    bool empty() const { return list_head == nullptr; }
+
+    void push_end(int n) {
+        DNode* new_node = new DNode(n, nullptr, list_tail);
+        if (empty()) list_head = new_node;
+        else list_tail->set_next(new_node);
+        list_tail = new_node;
+    }
+
+    int pop_front() {
+        DNode* temp = list_head;
+        int value = temp->retrieve();
+        list_head = list_head->next();
+        if (list_head == nullptr) list_tail = nullptr;
+        else list_head->set_prev(nullptr);
+        delete temp;
+        return value;
+    }
+
+    int pop_end() {
+        DNode* temp = list_tail;
+        int value = temp->retrieve();
+        list_tail = list_tail->prev();
+        if (list_tail == nullptr) list_head = nullptr;
+        else list_tail->set_next(nullptr);
+        delete temp;
+        return value;
+    }
+};
+
+volatile long long benchmark_sink;   // keeps the benchmark loops from being optimized away
+
+// Steady-state FIFO: keep `depth` items queued, then push one / pop one.
+template <typename Queue>
+double fifo_benchmark(int depth, int ops) {
+    Queue q;
+    for (int i = 0; i < depth; ++i)
+        q.push_end(i);
+
+    long long checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < ops; ++i) {
+        q.push_end(i);
+        checksum += q.pop_front();
+    }
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    benchmark_sink = checksum;
+    return ms;
+}
+
+// Work-stealing style: the owner pops from the end, a thief from the front.
+template <typename Queue>
+double deque_benchmark(int depth, int ops) {
+    Queue q;
+    for (int i = 0; i < depth; ++i)
+        q.push_end(i);
+
+    long long checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < ops; ++i) {
+        q.push_end(i);
+        q.push_end(i);
+        checksum += q.pop_end();
+        checksum += q.pop_front();
+    }
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    benchmark_sink = checksum;
+    return ms;
+}
+
+int main() {
+    RingDeque dq;
+
+    cout << "Pushing end 10, 20, 30 and front 5, 1:\n";
+    dq.push_end(10);
+    dq.push_end(20);
+    dq.push_end(30);
+    dq.push_front(5);
+    dq.push_front(1);
+    dq.display();
+
+    cout << "\nFront: " << dq.front() << ", End: " << dq.end() << ", at(2): " << dq.at(2) << endl;
+    cout << "Popping front: " << dq.pop_front() << endl;
+    cout << "Popping end: " << dq.pop_end() << endl;
+    dq.display();
+
+    cout << "\nBatch push of 1..12 (wraps and grows):\n";
+    int values[12];
+    for (int i = 0; i < 12; ++i)
+        values[i] = i + 1;
+    dq.push_end(values, 12);
+    dq.display();
+
+    int out[8];
+    int taken = dq.pop_front(out, 8);
+    cout << "Batch pop of " << taken << " from the front, size now " << dq.size() << ":\n";
+    dq.display();
+
+    while (dq.try_pop_end()) {}
+    cout << "try_pop_front on empty deque has value? " << (dq.try_pop_front() ? "Yes" : "No") << endl;
+
+    const int OPS = 5000000;
+    cout << "\nFIFO, 1024 queued, " << OPS << " push_end/pop_front pairs:\n";
+    cout << "RingDeque: " << fifo_benchmark<RingDeque>(1024, OPS) << " ms\n";
+    cout << "CList:     " << fifo_benchmark<CList>(1024, OPS) << " ms\n";
+    cout << "DList:     " << fifo_benchmark<DList>(1024, OPS) << " ms\n";
+
+    const int DEQUE_OPS = 1000000;
+    cout << "\nDeque, 64 queued, " << DEQUE_OPS << " rounds of 2 push_end + pop_end + pop_front:\n";
+    cout << "RingDeque: " << deque_benchmark<RingDeque>(64, DEQUE_OPS) << " ms\n";
+    cout << "CList:     " << deque_benchmark<CList>(64, DEQUE_OPS) << " ms (pop_end walks the list)\n";
+    cout << "DList:     " << deque_benchmark<DList>(64, DEQUE_OPS) << " ms\n";
+
+    cout << "\nProgram finished successfully.\n";
+
+    return 0;
+}
@@ -0,0 +1,439 @@
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+using namespace std;
+
+// Same cold error path as doubly.cpp.
+[[gnu::cold, gnu::noinline]] void log_error([[maybe_unused]] const char* msg) {
+#ifndef NO_ERROR_LOG
+    cerr << msg;
+#endif
+}
+
+[[gnu::cold, gnu::noinline]] void log_index_error([[maybe_unused]] int max_index) {
+#ifndef NO_ERROR_LOG
+    cerr << "Invalid index! Must be between 0 and " << max_index << ".\n";
+#endif
+}
+
+const uint32_t NIL = 0xFFFFFFFF;   // "nullptr" for an index link
+
+// Doubly linked list kept in three parallel arrays instead of DNode objects:
+// values[i], next_index[i] and prev_index[i] describe slot i. Links are 32-bit
+// indices, and live slots are always packed into [0, size), so value-only
+// scans read one dense array and the whole list can be copied with memcpy.
+// The price is that slot numbers are not stable: every removal moves the last
+// slot into the hole, so a slot index obtained before a pop or erase may then
+// name a different element, or lie past the end.
+class IndexDList {
+private:
+    int* values;
+    uint32_t* next_index;
+    uint32_t* prev_index;
+    uint32_t list_head;
+    uint32_t list_tail;
+    int list_size;
+    int capacity;
+
+    void resize() {
+        int new_capacity = (capacity == 0) ? 4 : capacity * 2;
+        int* new_values = new int[new_capacity];
+        uint32_t* new_next = new uint32_t[new_capacity];
+        uint32_t* new_prev = new uint32_t[new_capacity];
+
+        if (list_size > 0) {
+            memcpy(new_values, values, list_size * sizeof(int));
+            memcpy(new_next, next_index, list_size * sizeof(uint32_t));
+            memcpy(new_prev, prev_index, list_size * sizeof(uint32_t));
+        }
+
+        delete[] values;
+        delete[] next_index;
+        delete[] prev_index;
+        values = new_values;
+        next_index = new_next;
+        prev_index = new_prev;
+        capacity = new_capacity;
+    }
+
+    uint32_t new_slot(int n, uint32_t next, uint32_t prev) {
+        if (list_size == capacity) {
+            resize();
+        }
+        uint32_t slot = list_size++;
+        values[slot] = n;
+        next_index[slot] = next;
+        prev_index[slot] = prev;
+        return slot;
+    }
+
+    // Unlinks slot i, then moves the last slot into the hole so the live
+    // slots stay packed. This takes the place of a free list.
+    void remove_slot(uint32_t i) {
+        uint32_t p = prev_index[i];
+        uint32_t q = next_index[i];
+        if (p != NIL) next_index[p] = q; else list_head = q;
+        if (q != NIL) prev_index[q] = p; else list_tail = p;
+
+        uint32_t last = list_size - 1;
+        if (i != last) {
+            values[i] = values[last];
+            next_index[i] = next_index[last];
+            prev_index[i] = prev_index[last];
+            if (prev_index[i] != NIL) next_index[prev_index[i]] = i; else list_head = i;
+            if (next_index[i] != NIL) prev_index[next_index[i]] = i; else list_tail = i;
+        }
+        --list_size;
+    }
+
+public:
+    IndexDList()
+        : values(nullptr), next_index(nullptr), prev_index(nullptr),
+          list_head(NIL), list_tail(NIL), list_size(0), capacity(0) {}
+
+    IndexDList(const IndexDList& other)
+        : values(nullptr), next_index(nullptr), prev_index(nullptr),
+          list_head(other.list_head), list_tail(other.list_tail),
+          list_size(other.list_size), capacity(other.list_size) {
+        if (capacity > 0) {
+            values = new int[capacity];
+            next_index = new uint32_t[capacity];
+            prev_index = new uint32_t[capacity];
+            memcpy(values, other.values, list_size * sizeof(int));
+            memcpy(next_index, other.next_index, list_size * sizeof(uint32_t));
+            memcpy(prev_index, other.prev_index, list_size * sizeof(uint32_t));
+        }
+    }
+
+    IndexDList& operator=(const IndexDList& other) {
+        if (this != &other) {
+            IndexDList copy(other);
+            swap(values, copy.values);
+            swap(next_index, copy.next_index);
+            swap(prev_index, copy.prev_index);
+            swap(list_head, copy.list_head);
+            swap(list_tail, copy.list_tail);
+            swap(list_size, copy.list_size);
+            swap(capacity, copy.capacity);
+        }
+        return *this;
+    }
+
+    ~IndexDList() {
+        delete[] values;
+        delete[] next_index;
+        delete[] prev_index;
+    }
+
+    bool empty() const {
+        return (list_size == 0);
+    }
+
+    int size() const {
+        return list_size;
+    }
+
+    // Slot of the first/last element. Valid only until the next pop_front(),
+    // pop_end() or erase(); pushes never move existing slots.
+    uint32_t head() const {
+        return list_head;
+    }
+
+    uint32_t tail() const {
+        return list_tail;
+    }
+
+    int front() const {
+        if (empty()) {
+            log_error("List is empty! Cannot access front element.\n");
+            return -1;
+        }
+        return values[list_head];
+    }
+
+    int end() const {
+        if (empty()) {
+            log_error("List is empty! Cannot access end element.\n");
+            return -1;
+        }
+        return values[list_tail];
+    }
+
+    optional<int> try_front() const {
+        if (empty()) return nullopt;
+        return values[list_head];
+    }
+
+    optional<int> try_end() const {
+        if (empty()) return nullopt;
+        return values[list_tail];
+    }
+
+    // Order does not matter for counting, so this is a straight array scan.
+    int count(int n) const {
+        int node_count = 0;
+        for (int i = 0; i < list_size; ++i) {
+            if (values[i] == n)
+                ++node_count;
+        }
+        return node_count;
+    }
+
+    void push_front(int n) {
+        uint32_t slot = new_slot(n, list_head, NIL);
+
+        if (list_head == NIL) {
+            list_head = list_tail = slot;
+        }
+        else {
+            prev_index[list_head] = slot;
+            list_head = slot;
+        }
+    }
+
+    void push_end(int n) {
+        uint32_t slot = new_slot(n, NIL, list_tail);
+
+        if (list_tail == NIL) {
+            list_head = list_tail = slot;
+        }
+        else {
+            next_index[list_tail] = slot;
+            list_tail = slot;
+        }
+    }
+
+    void push_between(int index, int n) {
+        if (index < 0 || index > list_size) {
+            log_index_error(list_size);
+            return;
+        }
+
+        if (index == 0) {
+            push_front(n);
+            return;
+        }
+
+        if (index == list_size) {
+            push_end(n);
+            return;
+        }
+
+        uint32_t ptr = list_head;
+        for (int i = 0; i < index - 1; ++i) {
+            ptr = next_index[ptr];
+        }
+
+        uint32_t slot = new_slot(n, next_index[ptr], ptr);
+        prev_index[next_index[ptr]] = slot;
+        next_index[ptr] = slot;
+    }
+
+    int pop_front() {
+        if (empty()) {
+            log_error("List is empty! Cannot pop front.\n");
+            return -1;
+        }
+
+        int value = values[list_head];
+        remove_slot(list_head);
+        return value;
+    }
+
+    int pop_end() {
+        if (empty()) {
+            log_error("List is empty! Cannot pop end.\n");
+            return -1;
+        }
+
+        int value = values[list_tail];
+        remove_slot(list_tail);
+        return value;
+    }
+
+    optional<int> try_pop_front() {
+        if (empty()) return nullopt;
+        return pop_front();
+    }
+
+    optional<int> try_pop_end() {
+        if (empty()) return nullopt;
+        return pop_end();
+    }
+
+    // Walks the slots from the top down: remove_slot() only ever moves the
+    // last slot, which has already been checked.
+    int erase(int n) {
+        int count_removed = 0;
+        for (int i = list_size - 1; i >= 0; --i) {
+            if (values[i] == n) {
+                remove_slot(i);
+                ++count_removed;
+            }
+        }
+        return count_removed;
+    }
+
+    // Bytes needed by serialize(): a small header plus the three packed arrays.
+    size_t serialized_size() const {
+        return 3 * sizeof(uint32_t) + list_size * (sizeof(int) + 2 * sizeof(uint32_t));
+    }
+
+    void serialize(unsigned char* out) const {
+        uint32_t header[3] = { (uint32_t)list_size, list_head, list_tail };
+        memcpy(out, header, sizeof(header));
+        out += sizeof(header);
+        memcpy(out, values, list_size * sizeof(int));
+        out += list_size * sizeof(int);
+        memcpy(out, next_index, list_size * sizeof(uint32_t));
+        out += list_size * sizeof(uint32_t);
+        memcpy(out, prev_index, list_size * sizeof(uint32_t));
+    }
+
+    void deserialize(const unsigned char* in) {
+        uint32_t header[3];
+        memcpy(header, in, sizeof(header));
+        in += sizeof(header);
+
+        list_size = 0;
+        while (capacity < (int)header[0])
+            resize();
+        list_size = (int)header[0];
+        list_head = header[1];
+        list_tail = header[2];
+
+        memcpy(values, in, list_size * sizeof(int));
+        in += list_size * sizeof(int);
+        memcpy(next_index, in, list_size * sizeof(uint32_t));
+        in += list_size * sizeof(uint32_t);
+        memcpy(prev_index, in, list_size * sizeof(uint32_t));
+    }
+
+    void display() const {
+        if (empty()) {
+            cout << "List is empty.\n";
+            return;
+        }
+
+        cout << "nullptr <- ";
+        for (uint32_t ptr = list_head; ptr != NIL; ptr = next_index[ptr]) {
+            cout << values[ptr];
+            if (next_index[ptr] != NIL)
+                cout << " <-> ";
+        }
+        cout << " -> nullptr\n";
+    }
+
+    void display_reverse() const {
+        if (empty()) {
+            cout << "List is empty.\n";
+            return;
+        }
+
+        cout << "nullptr <- ";
+        for (uint32_t ptr = list_tail; ptr != NIL; ptr = prev_index[ptr]) {
+            cout << values[ptr];
+            if (prev_index[ptr] != NIL)
+                cout << " <-> ";
+        }
+        cout << " -> nullptr\n";
+    }
+};
+
+// Pointer-based node from doubly.cpp, used as the baseline below.
+class DNode {
+private:
+    int value;
+    DNode* next_node;
+    DNode* prev_node;
+
+public:
+    DNode(int val = 0, DNode* next = nullptr, DNode* prev = nullptr)
+        : value(val), next_node(next), prev_node(prev) {}
+
+    int retrieve() const { return value; }
+    DNode* next() const { return next_node; }
+    void set_next(DNode* next) { next_node = next; }
+};
+
+int main() {
+    IndexDList lst;
+
+    cout << "Pushing front 10, 20, 30:\n";
+    lst.push_front(10);
+    lst.push_front(20);
+    lst.push_front(30);
+    lst.display();
+
+    cout << "\nPushing end 40, 50 and 25 at index 2:\n";
+    lst.push_end(40);
+    lst.push_end(50);
+    lst.push_between(2, 25);
+    lst.display();
+
+    cout << "\nDisplay in reverse:\n";
+    lst.display_reverse();
+
+    cout << "\nFront element: " << lst.front() << endl;
+    cout << "End element: " << lst.end() << endl;
+    cout << "Size of list: " << lst.size() << endl;
+    cout << "Counting how many times 20 appears: " << lst.count(20) << endl;
+
+    cout << "\nErasing all nodes with value 20:\n";
+    lst.erase(20);
+    lst.display();
+
+    cout << "\nPopping front: " << lst.pop_front() << endl;
+    cout << "Popping end: " << lst.pop_end() << endl;
+    lst.display();
+
+    cout << "\nRound trip through serialize/deserialize:\n";
+    unsigned char* buffer = new unsigned char[lst.serialized_size()];
+    lst.serialize(buffer);
+    IndexDList restored;
+    restored.deserialize(buffer);
+    delete[] buffer;
+    restored.display();
+
+    const int N = 2000000;
+    cout << "\nComparing against DNode for " << N << " elements:\n";
+
+    IndexDList big;
+    DNode* list_head = nullptr;
+    DNode* list_tail = nullptr;
+    for (int i = 0; i < N; ++i) {
+        big.push_end(i % 1000);
+        DNode* new_node = new DNode(i % 1000, nullptr, list_tail);
+        if (list_head == nullptr) list_head = new_node;
+        else list_tail->set_next(new_node);
+        list_tail = new_node;
+    }
+
+    cout << "Bytes per element, DNode: " << sizeof(DNode)
+         << ", IndexDList: " << sizeof(int) + 2 * sizeof(uint32_t) << endl;
+
+    auto start = chrono::steady_clock::now();
+    int dnode_hits = 0;
+    for (DNode* ptr = list_head; ptr != nullptr; ptr = ptr->next())
+        dnode_hits += (ptr->retrieve() == 7);
+    auto dnode_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    int index_hits = big.count(7);
+    auto index_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "count(7) over DNode chain: " << dnode_hits << " in " << dnode_time << " ms\n";
+    cout << "count(7) over IndexDList: " << index_hits << " in " << index_time << " ms\n";
+
+    while (list_head != nullptr) {
+        DNode* temp = list_head;
+        list_head = list_head->next();
+        delete temp;
+    }
+
+    cout << "\nProgram finished successfully.\n";
+
+    return 0;
+}
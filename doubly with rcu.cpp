@@ -0,0 +1,610 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Same cold error path as doubly.cpp.
+[[gnu::cold, gnu::noinline]] void log_error([[maybe_unused]] const char* msg) {
+#ifndef NO_ERROR_LOG
+    cerr << msg;
+#endif
+}
+
+[[gnu::cold, gnu::noinline]] void log_index_error([[maybe_unused]] int max_index) {
+#ifndef NO_ERROR_LOG
+    cerr << "Invalid index! Must be between 0 and " << max_index << ".\n";
+#endif
+}
+
+const int MAX_READERS = 64;
+const int RETIRE_BATCH = 64;    // unlinked nodes queued before the writer tries to free them
+
+// Epoch-based grace periods. A reader publishes the global epoch it saw on
+// entry and clears its slot (0 = quiescent) on exit. A node unlinked while the
+// global epoch was E can be freed once every active reader has published an
+// epoch greater than E: such a reader started after the unlink and cannot
+// reach the node.
+atomic<unsigned long long> global_epoch(1);
+
+struct alignas(64) ReaderSlot {
+    atomic<unsigned long long> epoch;
+    int depth;      // open ReadGuards on the owning thread; only it touches this
+
+    ReaderSlot() : epoch(0), depth(0) {}
+};
+
+ReaderSlot reader_slots[MAX_READERS];
+atomic<bool> reader_slot_taken[MAX_READERS];
+atomic<int> reader_limit(0);
+
+// Every reading thread owns one slot while it is alive.
+class ReaderRegistration {
+private:
+    int slot_id;
+
+public:
+    ReaderRegistration() : slot_id(-1) {
+        for (int i = 0; i < MAX_READERS; ++i) {
+            if (!reader_slot_taken[i].exchange(true)) {
+                slot_id = i;
+                break;
+            }
+        }
+        if (slot_id == -1)
+            throw overflow_error("Too many reader threads: no free epoch slot.");
+
+        int limit = reader_limit.load();
+        while (limit < slot_id + 1 && !reader_limit.compare_exchange_weak(limit, slot_id + 1)) {}
+    }
+
+    ~ReaderRegistration() { reader_slot_taken[slot_id].store(false); }
+
+    int id() const { return slot_id; }
+};
+
+ReaderSlot& my_reader_slot() {
+    thread_local ReaderRegistration registration;
+    return reader_slots[registration.id()];
+}
+
+// Marks the calling thread as inside a read-side critical section for its
+// lifetime. Guards nest (a for_each callback may call count()): only the
+// outermost one publishes an epoch and only its exit clears it, so an inner
+// guard ending never exposes nodes the outer traversal is still standing on.
+// A thread inside a guard must not call synchronize(), which would wait on it.
+class ReadGuard {
+private:
+    ReaderSlot& slot;
+
+public:
+    ReadGuard() : slot(my_reader_slot()) {
+        if (slot.depth++ > 0) return;
+        slot.epoch.store(global_epoch.load(memory_order_relaxed), memory_order_seq_cst);
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+
+    ~ReadGuard() {
+        if (--slot.depth == 0)
+            slot.epoch.store(0, memory_order_release);
+    }
+};
+
+// Links are atomic so readers can follow them while the writer relinks:
+// writers publish with release stores and readers follow with acquire loads.
+class RcuDNode {
+private:
+    int value;
+    atomic<RcuDNode*> next_node;
+    atomic<RcuDNode*> prev_node;
+    RcuDNode* next_retired;     // writer-only
+
+public:
+    RcuDNode(int val = 0, RcuDNode* next = nullptr, RcuDNode* prev = nullptr)
+        : value(val), next_node(next), prev_node(prev), next_retired(nullptr) {}
+
+    int retrieve() const { return value; }
+    RcuDNode* next() const { return next_node.load(memory_order_acquire); }
+    RcuDNode* prev() const { return prev_node.load(memory_order_acquire); }
+    void set_next(RcuDNode* next) { next_node.store(next, memory_order_release); }
+    void set_prev(RcuDNode* prev) { prev_node.store(prev, memory_order_release); }
+
+    friend class RcuDList;
+};
+
+// DList for read-mostly sharing. Readers (count, contains, for_each, display,
+// ...) take no lock and do no atomic read-modify-write: they only publish an
+// epoch in their own cache line and follow links. Writers serialize on
+// writer_mutex, and unlinked nodes go on a retired list until a grace period
+// has passed. A node is fully initialized before the release store that
+// publishes it, and an unlinked node keeps its own links, so a reader standing
+// on it can always carry on in either direction.
+class RcuDList {
+private:
+    atomic<RcuDNode*> list_head;
+    atomic<RcuDNode*> list_tail;
+    atomic<int> list_size;
+    mutex writer_mutex;
+
+    struct RetiredBatch {
+        RcuDNode* nodes;
+        unsigned long long epoch;
+    };
+    vector<RetiredBatch> retired;   // oldest batch first
+    RcuDNode* pending;              // unlinked since the last batch was closed
+    int pending_count;
+
+    void unlink(RcuDNode* ptr) {
+        RcuDNode* before = ptr->prev_node.load(memory_order_relaxed);
+        RcuDNode* after = ptr->next_node.load(memory_order_relaxed);
+        if (before != nullptr) before->set_next(after);
+        else list_head.store(after, memory_order_release);
+        if (after != nullptr) after->set_prev(before);
+        else list_tail.store(before, memory_order_release);
+        list_size.store(list_size.load(memory_order_relaxed) - 1, memory_order_relaxed);
+    }
+
+    // Caller holds writer_mutex.
+    void retire(RcuDNode* ptr) {
+        ptr->next_retired = pending;
+        pending = ptr;
+        if (++pending_count >= RETIRE_BATCH) {
+            close_batch();
+            reclaim();
+        }
+    }
+
+    // Stamps the pending nodes with the current epoch and starts a new one,
+    // so readers that enter from now on are known to be past the unlinks.
+    void close_batch() {
+        if (pending == nullptr) return;
+        retired.push_back({ pending, global_epoch.fetch_add(1, memory_order_seq_cst) });
+        pending = nullptr;
+        pending_count = 0;
+    }
+
+    static unsigned long long oldest_reader_epoch() {
+        atomic_thread_fence(memory_order_seq_cst);
+        unsigned long long oldest = ~0ULL;
+        int limit = reader_limit.load(memory_order_acquire);
+        for (int i = 0; i < limit; ++i) {
+            unsigned long long epoch = reader_slots[i].epoch.load(memory_order_acquire);
+            if (epoch != 0 && epoch < oldest)
+                oldest = epoch;
+        }
+        return oldest;
+    }
+
+    static void free_retired(RcuDNode* ptr) {
+        while (ptr != nullptr) {
+            RcuDNode* temp = ptr;
+            ptr = ptr->next_retired;
+            delete temp;
+        }
+    }
+
+    // Frees every batch whose grace period has ended; never waits.
+    void reclaim() {
+        if (retired.empty()) return;
+        unsigned long long oldest = oldest_reader_epoch();
+
+        size_t freed = 0;
+        while (freed < retired.size() && retired[freed].epoch < oldest) {
+            free_retired(retired[freed].nodes);
+            ++freed;
+        }
+        retired.erase(retired.begin(), retired.begin() + freed);
+    }
+
+public:
+    RcuDList() : list_head(nullptr), list_tail(nullptr), list_size(0), pending(nullptr), pending_count(0) {}
+
+    // No reader may still be inside the list.
+    ~RcuDList() {
+        RcuDNode* ptr = list_head.load();
+        while (ptr != nullptr) {
+            RcuDNode* temp = ptr;
+            ptr = ptr->next_node.load(memory_order_relaxed);
+            delete temp;
+        }
+        free_retired(pending);
+        for (RetiredBatch& batch : retired)
+            free_retired(batch.nodes);
+    }
+
+    RcuDList(const RcuDList&) = delete;
+    RcuDList& operator=(const RcuDList&) = delete;
+
+    bool empty() const {
+        return (list_head.load(memory_order_acquire) == nullptr);
+    }
+
+    int size() const {
+        return list_size.load(memory_order_relaxed);
+    }
+
+    void push_front(int n) {
+        lock_guard<mutex> guard(writer_mutex);
+        RcuDNode* old_head = list_head.load(memory_order_relaxed);
+        RcuDNode* new_node = new RcuDNode(n, old_head, nullptr);
+
+        list_head.store(new_node, memory_order_release);
+        if (old_head != nullptr) old_head->set_prev(new_node);
+        else list_tail.store(new_node, memory_order_release);
+        list_size.store(list_size.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    }
+
+    void push_end(int n) {
+        lock_guard<mutex> guard(writer_mutex);
+        RcuDNode* old_tail = list_tail.load(memory_order_relaxed);
+        RcuDNode* new_node = new RcuDNode(n, nullptr, old_tail);
+
+        if (old_tail != nullptr) old_tail->set_next(new_node);
+        else list_head.store(new_node, memory_order_release);
+        list_tail.store(new_node, memory_order_release);
+        list_size.store(list_size.load(memory_order_relaxed) + 1, memory_order_relaxed);
+    }
+
+    // The new node is fully linked to its neighbours before the release store
+    // that makes it reachable, like push_front/push_end. Walks from the nearer end.
+    void push_between(int index, int n) {
+        lock_guard<mutex> guard(writer_mutex);
+        int size_val = list_size.load(memory_order_relaxed);
+        if (index < 0 || index > size_val) {
+            log_index_error(size_val);
+            return;
+        }
+
+        RcuDNode* before;
+        RcuDNode* after;
+        if (index <= size_val / 2) {
+            before = nullptr;
+            after = list_head.load(memory_order_relaxed);
+            for (int i = 0; i < index; ++i) {
+                before = after;
+                after = after->next_node.load(memory_order_relaxed);
+            }
+        }
+        else {
+            before = list_tail.load(memory_order_relaxed);
+            after = nullptr;
+            for (int i = size_val; i > index; --i) {
+                after = before;
+                before = before->prev_node.load(memory_order_relaxed);
+            }
+        }
+
+        RcuDNode* new_node = new RcuDNode(n, after, before);
+        if (before != nullptr) before->set_next(new_node);
+        else list_head.store(new_node, memory_order_release);
+        if (after != nullptr) after->set_prev(new_node);
+        else list_tail.store(new_node, memory_order_release);
+        list_size.store(size_val + 1, memory_order_relaxed);
+    }
+
+    int pop_front() {
+        lock_guard<mutex> guard(writer_mutex);
+        RcuDNode* old_head = list_head.load(memory_order_relaxed);
+        if (old_head == nullptr) {
+            log_error("List is empty! Cannot pop front.\n");
+            return -1;
+        }
+
+        int value = old_head->retrieve();
+        unlink(old_head);
+        retire(old_head);
+        return value;
+    }
+
+    int pop_end() {
+        lock_guard<mutex> guard(writer_mutex);
+        RcuDNode* old_tail = list_tail.load(memory_order_relaxed);
+        if (old_tail == nullptr) {
+            log_error("List is empty! Cannot pop end.\n");
+            return -1;
+        }
+
+        int value = old_tail->retrieve();
+        unlink(old_tail);
+        retire(old_tail);
+        return value;
+    }
+
+    int erase(int n) {
+        lock_guard<mutex> guard(writer_mutex);
+        int count_removed = 0;
+        RcuDNode* ptr = list_head.load(memory_order_relaxed);
+
+        while (ptr != nullptr) {
+            RcuDNode* next_node = ptr->next_node.load(memory_order_relaxed);
+            if (ptr->retrieve() == n) {
+                unlink(ptr);
+                retire(ptr);
+                ++count_removed;
+            }
+            ptr = next_node;
+        }
+        return count_removed;
+    }
+
+    // Blocks until every node unlinked so far has been freed.
+    void synchronize() {
+        lock_guard<mutex> guard(writer_mutex);
+        close_batch();
+        reclaim();
+        while (!retired.empty()) {
+            this_thread::yield();
+            reclaim();
+        }
+    }
+
+    // Nodes unlinked but not yet freed.
+    int retired_count() {
+        lock_guard<mutex> guard(writer_mutex);
+        int total = pending_count;
+        for (RetiredBatch& batch : retired) {
+            for (RcuDNode* ptr = batch.nodes; ptr != nullptr; ptr = ptr->next_retired)
+                ++total;
+        }
+        return total;
+    }
+
+    // Read side: no locks and no read-modify-writes. A traversal sees every
+    // node that was in the list for its whole duration; nodes added or
+    // removed while it runs may or may not be seen.
+    template <typename Func>
+    void for_each(Func f) const {
+        ReadGuard guard;
+        for (RcuDNode* ptr = list_head.load(memory_order_acquire); ptr != nullptr; ptr = ptr->next())
+            f(ptr->retrieve());
+    }
+
+    template <typename Func>
+    void for_each_reverse(Func f) const {
+        ReadGuard guard;
+        for (RcuDNode* ptr = list_tail.load(memory_order_acquire); ptr != nullptr; ptr = ptr->prev())
+            f(ptr->retrieve());
+    }
+
+    int count(int n) const {
+        int node_count = 0;
+        for_each([&node_count, n](int value) {
+            if (value == n)
+                ++node_count;
+        });
+        return node_count;
+    }
+
+    bool contains(int n) const {
+        ReadGuard guard;
+        for (RcuDNode* ptr = list_head.load(memory_order_acquire); ptr != nullptr; ptr = ptr->next()) {
+            if (ptr->retrieve() == n)
+                return true;
+        }
+        return false;
+    }
+
+    int front() const {
+        ReadGuard guard;
+        RcuDNode* ptr = list_head.load(memory_order_acquire);
+        if (ptr == nullptr) {
+            log_error("List is empty! Cannot access front element.\n");
+            return -1;
+        }
+        return ptr->retrieve();
+    }
+
+    int end() const {
+        ReadGuard guard;
+        RcuDNode* ptr = list_tail.load(memory_order_acquire);
+        if (ptr == nullptr) {
+            log_error("List is empty! Cannot access end element.\n");
+            return -1;
+        }
+        return ptr->retrieve();
+    }
+
+    void display() const {
+        ReadGuard guard;
+        RcuDNode* ptr = list_head.load(memory_order_acquire);
+        if (ptr == nullptr) {
+            cout << "List is empty.\n";
+            return;
+        }
+
+        cout << "nullptr <- ";
+        for (; ptr != nullptr; ptr = ptr->next()) {
+            cout << ptr->retrieve();
+            if (ptr->next() != nullptr)
+                cout << " <-> ";
+        }
+        cout << " -> nullptr\n";
+    }
+
+    void display_reverse() const {
+        ReadGuard guard;
+        RcuDNode* ptr = list_tail.load(memory_order_acquire);
+        if (ptr == nullptr) {
+            cout << "List is empty.\n";
+            return;
+        }
+
+        cout << "nullptr <- ";
+        for (; ptr != nullptr; ptr = ptr->prev()) {
+            cout << ptr->retrieve();
+            if (ptr->prev() != nullptr)
+                cout << " <-> ";
+        }
+        cout << " -> nullptr\n";
+    }
+};
+
+// Baseline: a plain DList where readers take the writer's mutex.
+class DNode {
+private:
+    int value;
+    DNode* next_node;
+    DNode* prev_node;
+
+public:
+    DNode(int val = 0, DNode* next = nullptr, DNode* prev = nullptr)
+        : value(val), next_node(next), prev_node(prev) {}
+
+    int retrieve() const { return value; }
+    DNode* next() const { return next_node; }
+    DNode* prev() const { return prev_node; }
+    void set_next(DNode* next) { next_node = next; }
+    void set_prev(DNode* prev) { prev_node = prev; }
+};
+
+class MutexDList {
+private:
+    DNode* list_head;
+    DNode* list_tail;
+    mutable mutex list_mutex;
+
+public:
+    MutexDList() : list_head(nullptr), list_tail(nullptr) {}
+
+    ~MutexDList() {
+        while (list_head != nullptr) {
+            DNode* temp = list_head;
+            list_head = list_head->next();
+            delete temp;
+        }
+    }
+
+    void push_end(int n) {
+        lock_guard<mutex> guard(list_mutex);
+        DNode* new_node = new DNode(n, nullptr, list_tail);
+        if (list_head == nullptr) list_head = new_node;
+        else list_tail->set_next(new_node);
+        list_tail = new_node;
+    }
+
+    int pop_front() {
+        lock_guard<mutex> guard(list_mutex);
+        if (list_head == nullptr) return -1;
+        DNode* temp = list_head;
+        int value = temp->retrieve();
+        list_head = list_head->next();
+        if (list_head == nullptr) list_tail = nullptr;
+        else list_head->set_prev(nullptr);
+        delete temp;
+        return value;
+    }
+
+    int count(int n) const {
+        lock_guard<mutex> guard(list_mutex);
+        int node_count = 0;
+        for (DNode* ptr = list_head; ptr != nullptr; ptr = ptr->next()) {
+            if (ptr->retrieve() == n)
+                ++node_count;
+        }
+        return node_count;
+    }
+};
+
+// One writer rotates the list (push_end + pop_front) for the whole run while
+// reader_count threads call count(). Returns reader traversals per second and
+// stores the writer's rotations per second in writes_per_second.
+template <typename List>
+double read_benchmark(int reader_count, int list_length, int millis, double& writes_per_second) {
+    List lst;
+    for (int i = 0; i < list_length; ++i)
+        lst.push_end(i % 100);
+
+    atomic<bool> stop(false);
+    atomic<long long> traversals(0);
+    atomic<long long> checksum(0);
+    long long rotations = 0;
+
+    thread writer([&lst, &stop, &rotations]() {
+        int i = 0;
+        while (!stop.load(memory_order_relaxed)) {
+            lst.push_end(i++ % 100);
+            lst.pop_front();
+        }
+        rotations = i;
+    });
+
+    vector<thread> readers;
+    for (int r = 0; r < reader_count; ++r) {
+        readers.emplace_back([&lst, &stop, &traversals, &checksum]() {
+            long long local_count = 0;
+            long long local_sum = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                local_sum += lst.count(7);
+                ++local_count;
+            }
+            traversals += local_count;
+            checksum += local_sum;
+        });
+    }
+
+    this_thread::sleep_for(chrono::milliseconds(millis));
+    stop.store(true);
+    writer.join();
+    for (thread& th : readers)
+        th.join();
+
+    writes_per_second = rotations * 1000.0 / millis;
+    return traversals.load() * 1000.0 / millis;
+}
+
+int main() {
+    RcuDList lst;
+
+    cout << "Pushing front 10, 20, 30 and end 40, 50:\n";
+    lst.push_front(10);
+    lst.push_front(20);
+    lst.push_front(30);
+    lst.push_end(40);
+    lst.push_end(50);
+    lst.display();
+
+    cout << "\nInserting 25 at index 2 and 45 at index 5:\n";
+    lst.push_between(2, 25);
+    lst.push_between(5, 45);
+    lst.display();
+
+    cout << "\nDisplay in reverse:\n";
+    lst.display_reverse();
+
+    cout << "\nFront element: " << lst.front() << endl;
+    cout << "End element: " << lst.end() << endl;
+    cout << "Size of list: " << lst.size() << endl;
+    cout << "Counting how many times 20 appears: " << lst.count(20) << endl;
+
+    cout << "Nested reads, count() inside for_each():";
+    lst.for_each([&lst](int value) { cout << " " << value << "x" << lst.count(value); });
+    cout << endl;
+
+    cout << "\nErasing 20, popping front " << lst.pop_front() << " and end " << lst.pop_end() << ":\n";
+    lst.erase(20);
+    lst.display();
+
+    cout << "Nodes waiting for a grace period: " << lst.retired_count() << endl;
+    lst.synchronize();
+    cout << "After synchronize(): " << lst.retired_count() << endl;
+
+    const int LENGTH = 10000;
+    const int MILLIS = 300;
+    cout << "\nReader traversals/s over " << LENGTH << " nodes with one writer running:\n";
+    cout << "readers\tRCU reads\tRCU writes\tmutex reads\tmutex writes\n";
+    for (int readers = 1; readers <= 8; readers *= 2) {
+        double rcu_writes, mutex_writes;
+        double rcu_reads = read_benchmark<RcuDList>(readers, LENGTH, MILLIS, rcu_writes);
+        double mutex_reads = read_benchmark<MutexDList>(readers, LENGTH, MILLIS, mutex_writes);
+        cout << readers << "\t" << rcu_reads << "\t\t" << rcu_writes
+             << "\t\t" << mutex_reads << "\t\t" << mutex_writes << endl;
+    }
+    cout << "(" << thread::hardware_concurrency() << " cores available)\n";
+
+    cout << "\nProgram finished successfully.\n";
+
+    return 0;
+}
@@ -1,6 +1,365 @@
 #include <iostream>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <unistd.h>
 using namespace std;
 
+const int PARALLEL_CHUNKS = 64;          // 64 to 128 chunks, set by the list size alone
+const int PARALLEL_MIN_SIZE = 100000;    // below this one thread is faster
+
+// Cold and out of line, as in singly.cpp; -DNO_ERROR_LOG compiles it out.
+[[gnu::cold, gnu::noinline]] void log_error([[maybe_unused]] const char* msg) {
+#ifndef NO_ERROR_LOG
+    cerr << msg;
+#endif
+}
+
+[[gnu::cold, gnu::noinline]] void log_index_error([[maybe_unused]] int max_index) {
+#ifndef NO_ERROR_LOG
+    cerr << "Invalid index! Must be between 0 and " << max_index << ".\n";
+#endif
+}
+
+enum DumpFormat { DUMP_TEXT, DUMP_CSV, DUMP_BINARY };
+
+// Formats values with to_chars into one large buffer and hands it to write()
+// in big pieces, instead of one operator<< per element like display().
+class DumpWriter {
+private:
+    static const int BUFFER_SIZE = 1 << 16;
+    char buffer[BUFFER_SIZE];
+    int used;
+    int fd;
+    DumpFormat format;
+    const char* separator;
+    bool first_item;
+    bool failed;
+
+    // Retries partial writes and EINTR. Any other error, or a write that makes
+    // no progress, marks the writer failed and drops everything after it.
+    void flush() {
+        int done = 0;
+        while (done < used && !failed) {
+            ssize_t n = write(fd, buffer + done, used - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) failed = true;
+            else done += (int)n;
+        }
+        used = 0;
+    }
+
+    void put(const char* s, int len) {
+        if (used + len > BUFFER_SIZE) flush();
+        memcpy(buffer + used, s, len);
+        used += len;
+    }
+
+    void put(const char* s) { put(s, (int)strlen(s)); }
+
+    void next_item() {
+        if (!first_item) put(separator);
+        first_item = false;
+    }
+
+public:
+    DumpWriter(int out_fd, DumpFormat fmt)
+        : used(0), fd(out_fd), format(fmt), separator(","), first_item(true), failed(false) {
+        if (fd == STDOUT_FILENO) cout.flush();   // keep ordering with earlier cout output
+    }
+
+    ~DumpWriter() { flush(); }
+
+    // Writes out what is buffered; false if any of the output was lost.
+    bool finish() {
+        flush();
+        return !failed;
+    }
+
+    void text(const char* s) {
+        if (format == DUMP_TEXT) put(s);
+    }
+
+    void text_value(int n) {
+        if (format != DUMP_TEXT) return;
+        if (used + 11 > BUFFER_SIZE) flush();
+        used = (int)(to_chars(buffer + used, buffer + BUFFER_SIZE, n).ptr - buffer);
+    }
+
+    void open(const char* prefix, const char* text_separator) {
+        if (format == DUMP_TEXT) separator = text_separator;
+        text(prefix);
+    }
+
+    void value(int n) {
+        if (format == DUMP_BINARY) {
+            put((const char*)&n, (int)sizeof(n));
+            return;
+        }
+        next_item();
+        if (used + 11 > BUFFER_SIZE) flush();
+        used = (int)(to_chars(buffer + used, buffer + BUFFER_SIZE, n).ptr - buffer);
+    }
+
+    // Marks values cut off by a first/last N limit.
+    void omitted() {
+        if (format != DUMP_TEXT) return;
+        next_item();
+        put("...");
+    }
+
+    void close(const char* suffix) {
+        if (format == DUMP_TEXT) put(suffix);
+        else if (format == DUMP_CSV) put("\n");
+    }
+};
+
+// Flushes a dump and reports a write that did not go through.
+bool finish_dump(DumpWriter& out) {
+    if (out.finish()) return true;
+    log_error("Dump failed! Could not write to the file descriptor.\n");
+    return false;
+}
+
+enum SummaryMode { SUMMARY_NONE, SUMMARY_EXACT, SUMMARY_BLOOM };
+
+struct SummaryStats {
+    SummaryMode mode;
+    long long memory_bytes;         // heap bytes held by the summary
+    long long lookups;              // count/erase calls that consulted it
+    long long ruled_out;            // lookups that proved the value absent, no walk
+    long long false_positives;      // Bloom said "maybe", the walk found nothing
+    double false_positive_rate;     // measured, over lookups of absent values
+    double expected_false_positive_rate;
+};
+
+// Optional companion to a list that knows which values it holds, so count()
+// and erase() can answer without a walk. SUMMARY_EXACT keeps a hash multiset
+// (value -> occurrences, open addressing) and answers count() in O(1).
+// SUMMARY_BLOOM keeps a counting Bloom filter of a fixed number of one-byte
+// counters: it only rules values out, but costs one byte per counter however
+// many values the list holds. A counter that reaches 255 sticks there, since
+// it can no longer tell how many values share it.
+class ValueSummary {
+private:
+    static const int BLOOM_HASHES = 4;
+
+    SummaryMode mode;
+    int* keys;
+    int* counts;                // 0 marks an empty slot
+    int table_capacity;
+    int table_used;
+    unsigned char* counters;
+    int counter_count;
+    int counters_in_use;
+    // Statistics only: lookups come from const count() calls that may run
+    // concurrently, so these are relaxed atomic counters.
+    mutable atomic<long long> lookups;
+    mutable atomic<long long> ruled_out;
+    mutable atomic<long long> false_positives;
+
+    static void bump(atomic<long long>& counter) {
+        counter.fetch_add(1, memory_order_relaxed);
+    }
+
+    static unsigned int mix(unsigned int x) {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    int find_slot(int n) const {
+        int mask = table_capacity - 1;
+        int slot = mix((unsigned int)n) & mask;
+        while (counts[slot] != 0 && keys[slot] != n)
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void grow_table() {
+        int* old_keys = keys;
+        int* old_counts = counts;
+        int old_capacity = table_capacity;
+
+        table_capacity = (old_capacity == 0) ? 16 : old_capacity * 2;
+        keys = new int[table_capacity];
+        counts = new int[table_capacity]();
+        for (int i = 0; i < old_capacity; ++i) {
+            if (old_counts[i] != 0) {
+                int slot = find_slot(old_keys[i]);
+                keys[slot] = old_keys[i];
+                counts[slot] = old_counts[i];
+            }
+        }
+
+        delete[] old_keys;
+        delete[] old_counts;
+    }
+
+    // Backward-shift deletion: pull later entries of the probe run into the
+    // hole, so lookups never need tombstones.
+    void remove_slot(int hole) {
+        int mask = table_capacity - 1;
+        int i = hole;
+        for (int j = (i + 1) & mask; counts[j] != 0; j = (j + 1) & mask) {
+            int home = mix((unsigned int)keys[j]) & mask;
+            bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (!stays) {
+                keys[i] = keys[j];
+                counts[i] = counts[j];
+                i = j;
+            }
+        }
+        counts[i] = 0;
+        --table_used;
+    }
+
+    void bloom_positions(int n, int* positions) const {
+        unsigned int h1 = mix((unsigned int)n);
+        unsigned int h2 = mix(h1 ^ 0x9e3779b9u) | 1;
+        for (int i = 0; i < BLOOM_HASHES; ++i)
+            positions[i] = (int)((h1 + i * h2) & (unsigned int)(counter_count - 1));
+    }
+
+    void release() {
+        delete[] keys;
+        delete[] counts;
+        delete[] counters;
+        keys = counts = nullptr;
+        counters = nullptr;
+        table_capacity = table_used = 0;
+        counter_count = counters_in_use = 0;
+    }
+
+public:
+    ValueSummary()
+        : mode(SUMMARY_NONE), keys(nullptr), counts(nullptr), table_capacity(0), table_used(0),
+          counters(nullptr), counter_count(0), counters_in_use(0),
+          lookups(0), ruled_out(0), false_positives(0) {}
+
+    ~ValueSummary() { release(); }
+
+    ValueSummary(const ValueSummary&) = delete;
+    ValueSummary& operator=(const ValueSummary&) = delete;
+
+    // Starts an empty summary; the owner adds its current values afterwards.
+    // bloom_counters is rounded up to a power of two.
+    void reset(SummaryMode new_mode, int bloom_counters) {
+        release();
+        mode = new_mode;
+        lookups.store(0, memory_order_relaxed);
+        ruled_out.store(0, memory_order_relaxed);
+        false_positives.store(0, memory_order_relaxed);
+        if (mode == SUMMARY_EXACT) {
+            grow_table();
+        }
+        else if (mode == SUMMARY_BLOOM) {
+            counter_count = 64;
+            while (counter_count < bloom_counters)
+                counter_count *= 2;
+            counters = new unsigned char[counter_count]();
+        }
+    }
+
+    void add(int n) {
+        if (mode == SUMMARY_EXACT) {
+            if (2 * (table_used + 1) > table_capacity)
+                grow_table();
+            int slot = find_slot(n);
+            if (counts[slot] == 0) {
+                keys[slot] = n;
+                ++table_used;
+            }
+            ++counts[slot];
+        }
+        else if (mode == SUMMARY_BLOOM) {
+            int positions[BLOOM_HASHES];
+            bloom_positions(n, positions);
+            for (int p : positions) {
+                if (counters[p] == 0) ++counters_in_use;
+                if (counters[p] != 255) ++counters[p];
+            }
+        }
+    }
+
+    void remove(int n) {
+        if (mode == SUMMARY_EXACT) {
+            int slot = find_slot(n);
+            if (counts[slot] != 0 && --counts[slot] == 0)
+                remove_slot(slot);
+        }
+        else if (mode == SUMMARY_BLOOM) {
+            int positions[BLOOM_HASHES];
+            bloom_positions(n, positions);
+            for (int p : positions) {
+                if (counters[p] != 0 && counters[p] != 255 && --counters[p] == 0)
+                    --counters_in_use;
+            }
+        }
+    }
+
+    bool enabled() const { return mode != SUMMARY_NONE; }
+
+    // Occurrences of n if the summary knows them, 0 if n is certainly
+    // absent, or -1 when the caller has to walk the list.
+    int lookup(int n) const {
+        if (mode == SUMMARY_NONE) return -1;
+        bump(lookups);
+
+        if (mode == SUMMARY_EXACT) {
+            int found = counts[find_slot(n)];
+            if (found == 0) bump(ruled_out);
+            return found;
+        }
+
+        int positions[BLOOM_HASHES];
+        bloom_positions(n, positions);
+        for (int p : positions) {
+            if (counters[p] == 0) {
+                bump(ruled_out);
+                return 0;
+            }
+        }
+        return -1;
+    }
+
+    // Reports the result of a walk that lookup() asked for.
+    void note_scan(int found) const {
+        if (mode == SUMMARY_BLOOM && found == 0)
+            bump(false_positives);
+    }
+
+    SummaryStats stats() const {
+        SummaryStats s;
+        s.mode = mode;
+        s.memory_bytes = (long long)table_capacity * 2 * sizeof(int) + counter_count;
+        s.lookups = lookups.load(memory_order_relaxed);
+        s.ruled_out = ruled_out.load(memory_order_relaxed);
+        s.false_positives = false_positives.load(memory_order_relaxed);
+
+        long long absent = (mode == SUMMARY_BLOOM) ? s.ruled_out + s.false_positives : 0;
+        s.false_positive_rate = (absent > 0) ? (double)s.false_positives / absent : 0.0;
+
+        double expected = 0.0;
+        if (mode == SUMMARY_BLOOM) {
+            double fill = (double)counters_in_use / counter_count;
+            expected = 1.0;
+            for (int i = 0; i < BLOOM_HASHES; ++i)
+                expected *= fill;
+        }
+        s.expected_false_positive_rate = expected;
+        return s;
+    }
+};
+
 class DNode {
 private:
     int value;
@@ -24,17 +383,617 @@ public:
     friend class DList;
 };
 
+const int MAX_LEVEL = 16;   // 4^16 positions, far beyond an int-sized list
+
+// Entry of DList's positional index. At each of its levels it links to the
+// neighbouring towers and records how many list positions the forward link
+// skips. The links live in the same block, right after the tower; DList
+// carves the blocks out of pooled chunks.
+class SkipTower {
+private:
+    struct Link {
+        SkipTower* next;
+        SkipTower* prev;
+        int span;
+    };
+
+    DNode* node;
+    int height;
+
+    SkipTower(DNode* n, int h) : node(n), height(h) {}
+
+    Link* links() { return reinterpret_cast<Link*>(this + 1); }
+    const Link* links() const { return reinterpret_cast<const Link*>(this + 1); }
+
+    static int block_size(int h) {
+        return (int)(sizeof(SkipTower) + h * sizeof(Link));
+    }
+
+    static SkipTower* place(void* block, DNode* n, int h) {
+        SkipTower* tower = new (block) SkipTower(n, h);
+        for (int k = 0; k < h; ++k)
+            tower->links()[k] = Link{ nullptr, nullptr, 0 };
+        return tower;
+    }
+
+public:
+    SkipTower* next(int k) const { return links()[k].next; }
+    SkipTower* prev(int k) const { return links()[k].prev; }
+    int span(int k) const { return links()[k].span; }
+
+    void set_next(int k, SkipTower* t) { links()[k].next = t; }
+    void set_prev(int k, SkipTower* t) { links()[k].prev = t; }
+    void set_span(int k, int s) { links()[k].span = s; }
+
+    friend class DList;
+};
+
+static_assert(sizeof(SkipTower) % alignof(SkipTower*) == 0, "tower links must stay aligned");
+
 class DList {
 private:
+    // Order-statistics skip index over the nodes, so at(), insert_at() and
+    // erase_at() take O(log n) instead of a walk from the head. About one
+    // node in four has a tower. Tower positions are stored relative to base
+    // (the position of head), which lets an un-indexed push_front/pop_front
+    // shift every position in O(1) by moving the base. The index is created
+    // by the first positional edit or by build_index(); until then the list
+    // carries only this pointer.
+    struct SkipIndex {
+        SkipTower* head;                    // sentinel of height MAX_LEVEL
+        SkipTower* level_tail[MAX_LEVEL];   // last tower per level, head if none
+        int tail_rank[MAX_LEVEL];           // relative position of level_tail
+        int levels;
+        int base;
+        unsigned int random_state;
+        char* pool_chunk;                   // chunks chain through their first word
+        int pool_left;                      // unused bytes at the end of pool_chunk
+        SkipTower* free_towers[MAX_LEVEL + 1];   // by height, chained through next(0)
+    };
+
+    static const int POOL_CHUNK_SIZE = 1 << 16;
+
+    // Predecessors kept while a bulk operation walks the list, so removed
+    // nodes drop their towers in the same pass.
+    struct IndexWalk {
+        SkipTower* update[MAX_LEVEL];
+        int rank[MAX_LEVEL];
+        int position;
+    };
+
     DNode* list_head;
     DNode* list_tail;
+    int list_size;
+    SkipIndex* skip;
+    ValueSummary summary;
+
+    // Chunk starts for the parallel_* traversals, found by one sampling walk
+    // and reused until the next mutation. Concurrent readers that find no
+    // cache each build one and publish it with a compare-and-swap; the losers
+    // drop theirs, so const calls never write shared state in place.
+    mutable atomic<vector<DNode*>*> splits;
+
+    void invalidate_splits() {
+        if (splits.load(memory_order_relaxed) != nullptr)
+            delete splits.exchange(nullptr, memory_order_relaxed);
+    }
+
+    SkipTower* new_tower(DNode* node, int h) {
+        void* block;
+        if (skip->free_towers[h] != nullptr) {
+            block = skip->free_towers[h];
+            skip->free_towers[h] = skip->free_towers[h]->next(0);
+        }
+        else {
+            int bytes = SkipTower::block_size(h);
+            if (bytes > skip->pool_left) {
+                char* chunk = new char[POOL_CHUNK_SIZE];
+                *reinterpret_cast<char**>(chunk) = skip->pool_chunk;
+                skip->pool_chunk = chunk;
+                skip->pool_left = POOL_CHUNK_SIZE - (int)sizeof(char*);
+            }
+            block = skip->pool_chunk + POOL_CHUNK_SIZE - skip->pool_left;
+            skip->pool_left -= bytes;
+        }
+        return SkipTower::place(block, node, h);
+    }
+
+    void free_tower(SkipTower* tower) {
+        tower->set_next(0, skip->free_towers[tower->height]);
+        skip->free_towers[tower->height] = tower;
+    }
+
+    int random_level() {
+        int h = 0;
+        unsigned int& state = skip->random_state;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        for (unsigned int bits = state; h < MAX_LEVEL && (bits & 3) == 0; bits >>= 2)
+            ++h;
+        return h;
+    }
+
+    // Moves base back to -1 so relative and absolute positions agree
+    // (relative = position + 1). Only the head spans and tail ranks change:
+    // O(levels).
+    void rebase() {
+        int shift = skip->base + 1;
+        if (shift == 0) return;
+        SkipTower* head = skip->head;
+        for (int k = 0; k < skip->levels; ++k) {
+            if (head->next(k) != nullptr)
+                head->set_span(k, head->span(k) + shift);
+            if (skip->level_tail[k] != head)
+                skip->tail_rank[k] += shift;
+        }
+        skip->base = -1;
+    }
+
+    // For every level, the last tower before position index and its relative
+    // position. Call rebase() first.
+    void find_path(int index, SkipTower** update, int* rank) const {
+        const SkipTower* cur = skip->head;
+        int r = 0;
+        update[0] = skip->head;
+        rank[0] = 0;
+        for (int k = skip->levels - 1; k >= 0; --k) {
+            while (cur->next(k) != nullptr && r + cur->span(k) < index + 1) {
+                r += cur->span(k);
+                cur = cur->next(k);
+            }
+            update[k] = const_cast<SkipTower*>(cur);
+            rank[k] = r;
+        }
+    }
+
+    // Finishes a lookup on the node chain, starting from the bottom-level tower.
+    DNode* walk_from(const SkipTower* tower, int position, int index) const {
+        DNode* ptr = list_head;
+        if (tower != skip->head) {
+            ptr = tower->node;
+        }
+        else {
+            position = 0;
+        }
+        for (; position < index; ++position)
+            ptr = ptr->next();
+        return ptr;
+    }
+
+    void trim_levels() {
+        while (skip->levels > 0 && skip->head->next(skip->levels - 1) == nullptr)
+            --skip->levels;
+    }
+
+    // Towers hold no resources, so dropping the chunks frees the index.
+    void free_index() {
+        if (skip == nullptr) return;
+        char* chunk = skip->pool_chunk;
+        while (chunk != nullptr) {
+            char* temp = chunk;
+            chunk = *reinterpret_cast<char**>(chunk);
+            delete[] temp;
+        }
+        delete skip;
+        skip = nullptr;
+    }
+
+    // Gives the last node, at relative position t, a tower of height h by
+    // linking it after the level tails: no descent. h must be > 0.
+    void link_tail_tower(DNode* node, int t, int h) {
+        SkipTower* tower = new_tower(node, h);
+        for (int k = 0; k < h; ++k) {
+            SkipTower* last = skip->level_tail[k];
+            last->set_next(k, tower);
+            last->set_span(k, t - skip->tail_rank[k]);
+            tower->set_prev(k, last);
+            skip->level_tail[k] = tower;
+            skip->tail_rank[k] = t;
+        }
+        if (h > skip->levels) skip->levels = h;
+    }
+
+    void link_after(DNode* prev, DNode* new_node) {
+        new_node->set_prev(prev);
+        new_node->set_next(prev == nullptr ? list_head : prev->next());
+        if (new_node->next() != nullptr) new_node->next()->set_prev(new_node);
+        else list_tail = new_node;
+        if (prev != nullptr) prev->set_next(new_node);
+        else list_head = new_node;
+    }
+
+    // Appends an existing node, keeping the index (if any) in step.
+    void link_end(DNode* node) {
+        invalidate_splits();
+        link_after(list_tail, node);
+        if (skip != nullptr) {
+            int h = random_level();
+            if (h > 0) {
+                if (skip->base >= list_size) rebase();   // head must stay before the new node
+                link_tail_tower(node, list_size - skip->base, h);
+            }
+        }
+        ++list_size;
+    }
+
+    // Gives the new first node a tower of height h: every tower moves up one
+    // position, and the new one links straight after head.
+    void link_front_tower(DNode* node, int h) {
+        rebase();
+        SkipTower* head = skip->head;
+        SkipTower* tower = new_tower(node, h);
+        for (int k = 0; k < MAX_LEVEL && (k < skip->levels || k < h); ++k) {
+            if (skip->level_tail[k] != head) ++skip->tail_rank[k];
+            if (k < h) {
+                SkipTower* next = head->next(k);
+                tower->set_next(k, next);
+                tower->set_span(k, (next != nullptr) ? head->span(k) : 0);
+                tower->set_prev(k, head);
+                if (next != nullptr) next->set_prev(k, tower);
+                else {
+                    skip->level_tail[k] = tower;
+                    skip->tail_rank[k] = 1;
+                }
+                head->set_next(k, tower);
+                head->set_span(k, 1);
+            }
+            else if (head->next(k) != nullptr) {
+                head->set_span(k, head->span(k) + 1);
+            }
+        }
+        if (h > skip->levels) skip->levels = h;
+    }
+
+    // Removes the tower of the first node; positions stay put because the
+    // caller moves base down with the node.
+    void unlink_front_tower(SkipTower* tower) {
+        SkipTower* head = skip->head;
+        for (int k = 0; k < tower->height; ++k) {
+            SkipTower* next = tower->next(k);
+            head->set_next(k, next);
+            if (next != nullptr) {
+                head->set_span(k, head->span(k) + tower->span(k));
+                next->set_prev(k, head);
+            }
+            else {
+                head->set_span(k, 0);
+                skip->level_tail[k] = head;
+                skip->tail_rank[k] = 0;
+            }
+        }
+        free_tower(tower);
+        trim_levels();
+    }
+
+    // Removes the tower of the last node, which is the tail of all its levels.
+    void unlink_tail_tower(SkipTower* tower) {
+        for (int k = 0; k < tower->height; ++k) {
+            SkipTower* prev = tower->prev(k);
+            skip->tail_rank[k] -= prev->span(k);
+            prev->set_next(k, nullptr);
+            prev->set_span(k, 0);
+            skip->level_tail[k] = prev;
+        }
+        free_tower(tower);
+        trim_levels();
+    }
+
+    // Indexed insert strictly inside the list (0 < index < list_size).
+    void insert_indexed(int index, int n, int h) {
+        invalidate_splits();
+        rebase();
+        SkipTower* update[MAX_LEVEL];
+        int rank[MAX_LEVEL];
+        find_path(index, update, rank);
+
+        DNode* prev = walk_from(update[0], rank[0] - 1, index - 1);
+        DNode* new_node = new DNode(n);
+        link_after(prev, new_node);
+        summary.add(n);
+
+        SkipTower* tower = (h > 0) ? new_tower(new_node, h) : nullptr;
+        int t = index + 1;
+        for (int k = 0; k < skip->levels; ++k) {
+            if (skip->level_tail[k] != skip->head && skip->tail_rank[k] >= t)
+                ++skip->tail_rank[k];
+            if (k < h) {
+                SkipTower* next = update[k]->next(k);
+                tower->set_next(k, next);
+                tower->set_prev(k, update[k]);
+                if (next != nullptr) {
+                    tower->set_span(k, update[k]->span(k) - (t - rank[k]) + 1);
+                    next->set_prev(k, tower);
+                }
+                else {
+                    skip->level_tail[k] = tower;
+                    skip->tail_rank[k] = t;
+                }
+                update[k]->set_next(k, tower);
+                update[k]->set_span(k, t - rank[k]);
+            }
+            else if (update[k]->next(k) != nullptr) {
+                update[k]->set_span(k, update[k]->span(k) + 1);
+            }
+        }
+        for (int k = skip->levels; k < h; ++k) {
+            skip->head->set_next(k, tower);
+            skip->head->set_span(k, t);
+            tower->set_prev(k, skip->head);
+            skip->level_tail[k] = tower;
+            skip->tail_rank[k] = t;
+        }
+        if (h > skip->levels) skip->levels = h;
+        ++list_size;
+    }
+
+    // Indexed erase strictly inside the list (0 < index < list_size - 1).
+    int erase_indexed(int index) {
+        invalidate_splits();
+        rebase();
+        SkipTower* update[MAX_LEVEL];
+        int rank[MAX_LEVEL];
+        find_path(index, update, rank);
+
+        int t = index + 1;
+        SkipTower* tower = nullptr;
+        if (skip->levels > 0 && update[0]->next(0) != nullptr && rank[0] + update[0]->span(0) == t)
+            tower = update[0]->next(0);
+
+        DNode* node = (tower != nullptr) ? tower->node : walk_from(update[0], rank[0] - 1, index);
+
+        for (int k = 0; k < skip->levels; ++k) {
+            if (tower != nullptr && k < tower->height) {
+                SkipTower* next = tower->next(k);
+                update[k]->set_next(k, next);
+                if (next != nullptr) {
+                    update[k]->set_span(k, update[k]->span(k) + tower->span(k) - 1);
+                    next->set_prev(k, update[k]);
+                    --skip->tail_rank[k];
+                }
+                else {
+                    update[k]->set_span(k, 0);
+                    skip->level_tail[k] = update[k];
+                    skip->tail_rank[k] = rank[k];
+                }
+            }
+            else {
+                if (update[k]->next(k) != nullptr)
+                    update[k]->set_span(k, update[k]->span(k) - 1);
+                if (skip->level_tail[k] != update[k])
+                    --skip->tail_rank[k];
+            }
+        }
+        if (tower != nullptr) free_tower(tower);
+        trim_levels();
+
+        int value = node->retrieve();
+        unlink(node);
+        delete node;
+        summary.remove(value);
+        --list_size;
+        return value;
+    }
+
+    void walk_begin(IndexWalk& walk) {
+        if (skip == nullptr) return;
+        rebase();
+        for (int k = 0; k < MAX_LEVEL; ++k) {
+            walk.update[k] = skip->head;
+            walk.rank[k] = 0;
+        }
+        walk.position = 0;
+    }
+
+    // The walk visits every node it passes, in order, as kept or removed.
+    void walk_keep(IndexWalk& walk, DNode* node) {
+        if (skip == nullptr) return;
+        ++walk.position;
+        SkipTower* tower = (skip->levels > 0) ? walk.update[0]->next(0) : nullptr;
+        if (tower == nullptr || tower->node != node) return;
+        for (int k = 0; k < tower->height; ++k) {
+            walk.update[k] = tower;
+            walk.rank[k] = walk.position;
+        }
+    }
+
+    // Same span bookkeeping as erase_indexed(), with the predecessors
+    // already at hand: O(levels), no descent.
+    void walk_remove(IndexWalk& walk, DNode* node) {
+        if (skip == nullptr) return;
+        SkipTower* tower = (skip->levels > 0) ? walk.update[0]->next(0) : nullptr;
+        if (tower != nullptr && tower->node != node) tower = nullptr;
+
+        for (int k = 0; k < skip->levels; ++k) {
+            SkipTower* u = walk.update[k];
+            if (tower != nullptr && k < tower->height) {
+                SkipTower* next = tower->next(k);
+                u->set_next(k, next);
+                if (next != nullptr) {
+                    u->set_span(k, u->span(k) + tower->span(k) - 1);
+                    next->set_prev(k, u);
+                    --skip->tail_rank[k];
+                }
+                else {
+                    u->set_span(k, 0);
+                    skip->level_tail[k] = u;
+                    skip->tail_rank[k] = walk.rank[k];
+                }
+            }
+            else {
+                if (u->next(k) != nullptr)
+                    u->set_span(k, u->span(k) - 1);
+                if (skip->level_tail[k] != u)
+                    --skip->tail_rank[k];
+            }
+        }
+        if (tower != nullptr) free_tower(tower);
+    }
+
+    void walk_end() {
+        if (skip != nullptr) trim_levels();
+    }
+
+    // Bulk operations unlink first and free everything here in one go.
+    static void free_chain(DNode* ptr) {
+        while (ptr != nullptr) {
+            DNode* temp = ptr;
+            ptr = ptr->next();
+            delete temp;
+        }
+    }
+
+    // Unlinks ptr from this list; its own links are left for the caller.
+    void unlink(DNode* ptr) {
+        if (ptr->prev() != nullptr) ptr->prev()->set_next(ptr->next());
+        else list_head = ptr->next();
+        if (ptr->next() != nullptr) ptr->next()->set_prev(ptr->prev());
+        else list_tail = ptr->prev();
+    }
+
+    // Single walk: keep every stride-th node, and when the sample buffer fills
+    // drop every other sample and double the stride. Ends with between
+    // PARALLEL_CHUNKS and 2 * PARALLEL_CHUNKS evenly spaced starts (fewer
+    // for a list shorter than that).
+    vector<DNode*>* build_splits() const {
+        vector<DNode*>* points = new vector<DNode*>;
+        points->reserve(2 * PARALLEL_CHUNKS);
+        int stride = 1;
+        int position = 0;
+
+        for (DNode* ptr = list_head; ptr != nullptr; ptr = ptr->next(), ++position) {
+            if (position % stride != 0) continue;
+            if ((int)points->size() == 2 * PARALLEL_CHUNKS) {
+                for (int i = 0; i < PARALLEL_CHUNKS; ++i)
+                    (*points)[i] = (*points)[2 * i];
+                points->resize(PARALLEL_CHUNKS);
+                stride *= 2;
+            }
+            if (position % stride == 0)
+                points->push_back(ptr);
+        }
+        return points;
+    }
+
+    const vector<DNode*>& split_points() const {
+        vector<DNode*>* cached = splits.load(memory_order_acquire);
+        if (cached != nullptr) return *cached;
+
+        vector<DNode*>* fresh = build_splits();
+        if (splits.compare_exchange_strong(cached, fresh, memory_order_acq_rel, memory_order_acquire))
+            return *fresh;
+        delete fresh;
+        return *cached;
+    }
+
+    // Calls chunk_func(chunk, first, last) for every chunk, spreading the
+    // chunks round-robin over the worker threads. Returns the chunk count.
+    template <typename ChunkFunc>
+    int run_chunks(ChunkFunc chunk_func, int thread_count) const {
+        const vector<DNode*>& points = split_points();
+        int chunk_count = (int)points.size();
+
+        if (thread_count <= 0)
+            thread_count = (int)thread::hardware_concurrency();
+        if (thread_count <= 0 || list_size < PARALLEL_MIN_SIZE)
+            thread_count = 1;
+        if (thread_count > chunk_count)
+            thread_count = chunk_count;
+
+        auto worker = [&points, &chunk_func, chunk_count, thread_count](int first_chunk) {
+            for (int c = first_chunk; c < chunk_count; c += thread_count) {
+                DNode* last = (c + 1 < chunk_count) ? points[c + 1] : nullptr;
+                chunk_func(c, points[c], last);
+            }
+        };
+
+        vector<thread> threads;
+        for (int t = 1; t < thread_count; ++t)
+            threads.emplace_back(worker, t);
+        worker(0);
+        for (thread& th : threads)
+            th.join();
+        return chunk_count;
+    }
+
+    // Shared by dump() and dump_reverse(); a last-N limit steps back from the
+    // far end instead of counting the whole list.
+    bool dump_walk(int fd, DumpFormat format, int limit, bool from_back, bool reverse) const {
+        DumpWriter out(fd, format);
+        if (empty()) {
+            out.text("List is empty.\n");
+            return finish_dump(out);
+        }
+
+        auto forward = [reverse](DNode* ptr) { return reverse ? ptr->prev() : ptr->next(); };
+        auto backward = [reverse](DNode* ptr) { return reverse ? ptr->next() : ptr->prev(); };
+
+        DNode* ptr = reverse ? list_tail : list_head;
+        if (limit > 0 && from_back) {
+            ptr = reverse ? list_head : list_tail;
+            for (int i = 1; i < limit && backward(ptr) != nullptr; ++i)
+                ptr = backward(ptr);
+        }
+
+        out.open("nullptr <- ", " <-> ");
+        if (backward(ptr) != nullptr) out.omitted();
+        for (int shown = 0; ptr != nullptr && (limit < 0 || shown < limit); ++shown) {
+            out.value(ptr->retrieve());
+            ptr = forward(ptr);
+        }
+        if (ptr != nullptr) out.omitted();
+        out.close(" -> nullptr\n");
+        return finish_dump(out);
+    }
 
 public:
-    DList() : list_head(nullptr), list_tail(nullptr) {}
+    DList()
+        : list_head(nullptr), list_tail(nullptr), list_size(0), skip(nullptr), splits(nullptr) {}
 
     ~DList() {
-        while (!empty())
-            pop_front();
+        invalidate_splits();
+        free_index();
+        free_chain(list_head);
+    }
+
+    // Builds the positional index in one walk if it does not exist yet. The
+    // first insert_at/erase_at (or push_between/try_erase_at inside the list)
+    // does this on its own; at() on a list without an index walks from the
+    // nearer end instead, since a const read must not build it.
+    void build_index() {
+        if (skip != nullptr) return;
+        skip = new SkipIndex;
+        skip->pool_chunk = nullptr;
+        skip->pool_left = 0;
+        for (int h = 0; h <= MAX_LEVEL; ++h)
+            skip->free_towers[h] = nullptr;
+        skip->head = new_tower(nullptr, MAX_LEVEL);
+        for (int k = 0; k < MAX_LEVEL; ++k) {
+            skip->level_tail[k] = skip->head;
+            skip->tail_rank[k] = 0;
+        }
+        skip->levels = 0;
+        skip->base = -1;
+        skip->random_state = 2463534242u;
+
+        int position = 0;
+        for (DNode* ptr = list_head; ptr != nullptr; ptr = ptr->next()) {
+            ++position;
+            int h = random_level();
+            if (h > 0) link_tail_tower(ptr, position, h);
+        }
+    }
+
+    // Keeps a summary of the values (see ValueSummary) from now on, built
+    // from the current contents in one walk. SUMMARY_NONE drops it.
+    void enable_summary(SummaryMode mode, int bloom_counters = 1 << 16) {
+        summary.reset(mode, bloom_counters);
+        for (DNode* ptr = list_head; ptr != nullptr; ptr = ptr->next())
+            summary.add(ptr->retrieve());
+    }
+
+    SummaryStats summary_stats() const {
+        return summary.stats();
     }
 
     bool empty() const {
@@ -42,26 +1001,42 @@ public:
     }
 
     int size() const {
-        int count = 0;
-        for (DNode* ptr = list_head; ptr != nullptr; ptr = ptr->next())
-            ++count;
-        return count;
+        return list_size;
+    }
+
+    // Unchecked variants: the caller guarantees the list is not empty.
+    int front_unchecked() const {
+        return list_head->retrieve();
+    }
+
+    int end_unchecked() const {
+        return list_tail->retrieve();
     }
 
     int front() const {
         if (empty()) {
-            cerr << "List is empty! Cannot access front element.\n";
+            log_error("List is empty! Cannot access front element.\n");
             return -1;
         }
-        return list_head->retrieve();
+        return front_unchecked();
     }
 
     int end() const {
         if (empty()) {
-            cerr << "List is empty! Cannot access end element.\n";
+            log_error("List is empty! Cannot access end element.\n");
             return -1;
         }
-        return list_tail->retrieve();
+        return end_unchecked();
+    }
+
+    optional<int> try_front() const {
+        if (empty()) return nullopt;
+        return front_unchecked();
+    }
+
+    optional<int> try_end() const {
+        if (empty()) return nullopt;
+        return end_unchecked();
     }
 
     DNode* head() const {
@@ -73,135 +1048,407 @@ public:
     }
 
     int count(int n) const {
+        int known = summary.lookup(n);
+        if (known >= 0) return known;
+
         int node_count = 0;
         for (DNode* ptr = head(); ptr != nullptr; ptr = ptr->next()) {
             if (ptr->retrieve() == n)
                 ++node_count;
         }
+        summary.note_scan(node_count);
         return node_count;
     }
 
+    // With an index, one push in four also links a tower next to the index
+    // head or after the level tails: O(height), with no descent.
     void push_front(int n) {
-        DNode* new_node = new DNode(n, list_head, nullptr);
+        invalidate_splits();
+        DNode* new_node = new DNode(n);
+        link_after(nullptr, new_node);
+        summary.add(n);
+        ++list_size;
+        if (skip == nullptr) return;
 
-        if (empty()) {
-            list_head = list_tail = new_node;
-        } 
-        else {
-            list_head->set_prev(new_node);
-            list_head = new_node;
-        }
+        int h = random_level();
+        if (h > 0) link_front_tower(new_node, h);
+        else ++skip->base;
     }
 
     void push_end(int n) {
-        DNode* new_node = new DNode(n, nullptr, list_tail);
-
-        if (empty()) {
-            list_head = list_tail = new_node;
-        }
-        else {
-            list_tail->set_next(new_node);
-            list_tail = new_node;
-        }
+        link_end(new DNode(n));
+        summary.add(n);
     }
 
     void push_between(int index, int n) {
-        int size_val = size();
+        if (!try_push_between(index, n))
+            log_index_error(size());
+    }
 
-        if (index < 0 || index > size_val) {
-            cerr << "Invalid index! Must be between 0 and " << size_val << ".\n";
-            return;
+    bool try_push_between(int index, int n) {
+        if (index < 0 || index > list_size) {
+            return false;
         }
 
         if (index == 0) {
             push_front(n);
-            return;
         }
-
-        if (index == size_val) {
+        else if (index == list_size) {
             push_end(n);
-            return;
         }
+        else {
+            build_index();
+            insert_indexed(index, n, random_level());
+        }
+        return true;
+    }
 
-        DNode* ptr = list_head;
-        for (int i = 0; i < index - 1; ++i) {
-            ptr = ptr->next();
+    void insert_at(int index, int n) {
+        push_between(index, n);
+    }
+
+    int erase_at(int index) {
+        optional<int> value = try_erase_at(index);
+        if (!value) {
+            log_index_error(list_size - 1);
+            return -1;
         }
+        return *value;
+    }
 
-        DNode* new_node = new DNode(n, ptr->next(), ptr);
-        ptr->next()->set_prev(new_node);  
-        ptr->set_next(new_node);          
+    optional<int> try_erase_at(int index) {
+        if (index < 0 || index >= list_size) return nullopt;
+        if (index == 0) return pop_front_unchecked();
+        if (index == list_size - 1) return pop_end_unchecked();
+        build_index();
+        return erase_indexed(index);
     }
 
-    int pop_front() {
-        if (empty()) {
-            cerr << "List is empty! Cannot pop front.\n";
+    int at(int index) const {
+        optional<int> value = try_at(index);
+        if (!value) {
+            log_index_error(list_size - 1);
             return -1;
         }
+        return *value;
+    }
 
-        int value = list_head->retrieve();
-        DNode* temp = list_head;
+    optional<int> try_at(int index) const {
+        if (index < 0 || index >= list_size) return nullopt;
 
-        if (list_head == list_tail) {
+        if (skip == nullptr) {
+            DNode* ptr;
+            if (index < list_size / 2) {
+                ptr = list_head;
+                for (int i = 0; i < index; ++i)
+                    ptr = ptr->next();
+            }
+            else {
+                ptr = list_tail;
+                for (int i = list_size - 1; i > index; --i)
+                    ptr = ptr->prev();
+            }
+            return ptr->retrieve();
+        }
 
-            list_head = list_tail = nullptr;
+        // Same descent as find_path(), but read-only, so it works on relative
+        // positions instead of rebasing first.
+        const SkipTower* cur = skip->head;
+        int r = 0;
+        int target = index - skip->base;
+        for (int k = skip->levels - 1; k >= 0; --k) {
+            while (cur->next(k) != nullptr && r + cur->span(k) <= target) {
+                r += cur->span(k);
+                cur = cur->next(k);
+            }
         }
-        else {
-            list_head = list_head->next();
-            list_head->set_prev(nullptr);
+        return walk_from(cur, skip->base + r, index)->retrieve();
+    }
+
+    // O(1), plus O(height) when the node being removed carries a tower.
+    int pop_front_unchecked() {
+        invalidate_splits();
+        DNode* temp = list_head;
+        if (skip != nullptr) {
+            // Positions, not the tower, tell whether the node has one: the
+            // index head stays in cache.
+            SkipTower* first = skip->head->next(0);
+            if (first != nullptr && skip->head->span(0) + skip->base == 0) unlink_front_tower(first);
+            --skip->base;
         }
 
+        int value = temp->retrieve();
+        unlink(temp);
         delete temp;
+        summary.remove(value);
+        --list_size;
         return value;
     }
 
-    int pop_end() {
+    int pop_end_unchecked() {
+        invalidate_splits();
+        DNode* temp = list_tail;
+        if (skip != nullptr) {
+            SkipTower* last = skip->level_tail[0];
+            if (last != skip->head && skip->tail_rank[0] + skip->base == list_size - 1) unlink_tail_tower(last);
+        }
+
+        int value = temp->retrieve();
+        unlink(temp);
+        delete temp;
+        summary.remove(value);
+        --list_size;
+        return value;
+    }
+
+    int pop_front() {
         if (empty()) {
-            cerr << "List is empty! Cannot pop end.\n";
+            log_error("List is empty! Cannot pop front.\n");
             return -1;
         }
+        return pop_front_unchecked();
+    }
 
-        int value = list_tail->retrieve();
-        DNode* temp = list_tail;
-
-        if (list_head == list_tail) {
-            
-            list_head = list_tail = nullptr;
-        } else {
-            list_tail = list_tail->prev();
-            list_tail->set_next(nullptr);
+    int pop_end() {
+        if (empty()) {
+            log_error("List is empty! Cannot pop end.\n");
+            return -1;
         }
+        return pop_end_unchecked();
+    }
 
-        delete temp;
-        return value;
+    optional<int> try_pop_front() {
+        if (empty()) return nullopt;
+        return pop_front_unchecked();
     }
 
+    optional<int> try_pop_end() {
+        if (empty()) return nullopt;
+        return pop_end_unchecked();
+    }
+
+    // With a summary, an absent value returns at once, and in exact mode the
+    // walk stops after the last occurrence. Towers of removed nodes are
+    // unlinked during the walk.
     int erase(int n) {
+        int known = summary.lookup(n);
+        if (known == 0) return 0;
         int count_removed = 0;
         DNode* ptr = list_head;
+        IndexWalk walk;
+        walk_begin(walk);
 
-        while (ptr != nullptr) {
+        while (ptr != nullptr && count_removed != known) {
             DNode* next_node = ptr->next(); 
 
             if (ptr->retrieve() == n) {
-                if (ptr == list_head) {
-                    pop_front();
-                }
-                else if (ptr == list_tail) {
-                    pop_end(); 
-                }
-                else {
-                    ptr->prev()->set_next(ptr->next());
-                    ptr->next()->set_prev(ptr->prev());
-                    delete ptr;
-                }
+                walk_remove(walk, ptr);
+                unlink(ptr);
+                delete ptr;
+                summary.remove(n);
                 ++count_removed;
             }
+            else {
+                walk_keep(walk, ptr);
+            }
             ptr = next_node; 
         }
+
+        walk_end();
+        if (known < 0) summary.note_scan(count_removed);
+        if (count_removed > 0) invalidate_splits();
+        list_size -= count_removed;
+        return count_removed;
+    }
+
+    // Removes every value for which pred is true in a single pass.
+    template <typename Pred>
+    int erase_if(Pred pred) {
+        int count_removed = 0;
+        DNode* garbage = nullptr;
+        IndexWalk walk;
+        walk_begin(walk);
+
+        for (DNode* ptr = list_head; ptr != nullptr; ) {
+            DNode* next_node = ptr->next();
+            if (pred(ptr->retrieve())) {
+                walk_remove(walk, ptr);
+                unlink(ptr);
+                ptr->set_next(garbage);
+                garbage = ptr;
+                summary.remove(ptr->retrieve());
+                ++count_removed;
+            }
+            else {
+                walk_keep(walk, ptr);
+            }
+            ptr = next_node;
+        }
+
+        walk_end();
+        if (count_removed > 0) invalidate_splits();
+        list_size -= count_removed;
+        free_chain(garbage);
+        return count_removed;
+    }
+
+    // Collapses runs of equal neighbouring values to one node.
+    int unique() {
+        int count_removed = 0;
+        DNode* garbage = nullptr;
+        DNode* ptr = list_head;
+        IndexWalk walk;
+        walk_begin(walk);
+        if (ptr != nullptr) walk_keep(walk, ptr);
+
+        while (ptr != nullptr && ptr->next() != nullptr) {
+            DNode* next_node = ptr->next();
+            if (next_node->retrieve() == ptr->retrieve()) {
+                walk_remove(walk, next_node);
+                unlink(next_node);
+                next_node->set_next(garbage);
+                garbage = next_node;
+                summary.remove(next_node->retrieve());
+                ++count_removed;
+            } else {
+                ptr = next_node;
+                walk_keep(walk, ptr);
+            }
+        }
+
+        walk_end();
+        if (count_removed > 0) invalidate_splits();
+        list_size -= count_removed;
+        free_chain(garbage);
+        return count_removed;
+    }
+
+    // Moves the nodes for which pred is true, in order, to the end of matching;
+    // the rest stay here. Nodes are relinked, never copied.
+    template <typename Pred>
+    void partition(Pred pred, DList& matching) {
+        if (&matching == this) return;
+        IndexWalk walk;
+        walk_begin(walk);
+
+        for (DNode* ptr = list_head; ptr != nullptr; ) {
+            DNode* next_node = ptr->next();
+            if (pred(ptr->retrieve())) {
+                walk_remove(walk, ptr);
+                unlink(ptr);
+                --list_size;
+                summary.remove(ptr->retrieve());
+                matching.link_end(ptr);
+                matching.summary.add(ptr->retrieve());
+            }
+            else {
+                walk_keep(walk, ptr);
+            }
+            ptr = next_node;
+        }
+
+        walk_end();
+        invalidate_splits();
+    }
+
+    // Removes positions [first, last); a range running past the end stops there.
+    int remove_range(int first, int last) {
+        if (first < 0 || last < first) {
+            log_error("Invalid range! Need 0 <= first <= last.\n");
+            return 0;
+        }
+
+        IndexWalk walk;
+        walk_begin(walk);
+        DNode* ptr = list_head;
+        for (int i = 0; i < first && ptr != nullptr; ++i) {
+            walk_keep(walk, ptr);
+            ptr = ptr->next();
+        }
+
+        DNode* garbage = ptr;
+        DNode* before = (ptr != nullptr) ? ptr->prev() : nullptr;
+        DNode* garbage_tail = nullptr;
+        int count_removed = 0;
+        while (ptr != nullptr && count_removed < last - first) {
+            walk_remove(walk, ptr);
+            garbage_tail = ptr;
+            summary.remove(ptr->retrieve());
+            ptr = ptr->next();
+            ++count_removed;
+        }
+        walk_end();
+        if (count_removed == 0) return 0;
+
+        garbage_tail->set_next(nullptr);
+        if (before != nullptr) before->set_next(ptr);
+        else list_head = ptr;
+        if (ptr != nullptr) ptr->set_prev(before);
+        else list_tail = before;
+
+        invalidate_splits();
+        list_size -= count_removed;
+        free_chain(garbage);
         return count_removed;
     }
 
+    // The parallel_* traversals split the list into PARALLEL_CHUNKS to
+    // 2 * PARALLEL_CHUNKS chunks and run them on up to thread_count threads
+    // (0 = one per core). Several may run at once on the same list, but none
+    // may overlap with a mutation of it.
+    template <typename Func>
+    void parallel_for_each(Func f, int thread_count = 0) const {
+        run_chunks([&f](int, DNode* first, DNode* last) {
+            for (DNode* ptr = first; ptr != last; ptr = ptr->next())
+                f(ptr->retrieve());
+        }, thread_count);
+    }
+
+    // Each chunk folds its values left to right starting from identity, then
+    // the chunk results are combined in list order, so the result is the same
+    // for any thread count.
+    template <typename T, typename Accumulate, typename Combine>
+    T parallel_reduce(T identity, Accumulate accumulate, Combine combine, int thread_count = 0) const {
+        // One cache line per chunk result: no false sharing between workers,
+        // and no bit packing when T is bool (vector<bool> would race).
+        struct alignas(64) Partial {
+            T value;
+        };
+        vector<Partial> partial(2 * PARALLEL_CHUNKS, Partial{ identity });
+
+        int chunk_count = run_chunks([&partial, &accumulate](int chunk, DNode* first, DNode* last) {
+            T acc = partial[chunk].value;
+            for (DNode* ptr = first; ptr != last; ptr = ptr->next())
+                acc = accumulate(acc, ptr->retrieve());
+            partial[chunk].value = acc;
+        }, thread_count);
+
+        T result = identity;
+        for (int c = 0; c < chunk_count; ++c)
+            result = combine(result, partial[c].value);
+        return result;
+    }
+
+    int parallel_count(int n, int thread_count = 0) const {
+        return parallel_reduce(0,
+            [n](int acc, int value) { return acc + (value == n); },
+            [](int a, int b) { return a + b; },
+            thread_count);
+    }
+
+    // Buffered alternative to display() for large lists. DUMP_TEXT matches the
+    // display() format, DUMP_CSV writes comma-separated values and DUMP_BINARY
+    // the raw ints. A non-negative limit keeps only the first limit values, or
+    // the last ones when from_back is set. Returns false, after logging it,
+    // if the output could not be written.
+    bool dump(int fd, DumpFormat format = DUMP_TEXT, int limit = -1, bool from_back = false) const {
+        return dump_walk(fd, format, limit, from_back, false);
+    }
+
+    bool dump_reverse(int fd, DumpFormat format = DUMP_TEXT, int limit = -1, bool from_back = false) const {
+        return dump_walk(fd, format, limit, from_back, true);
+    }
+
     void display() const {
         if (empty()) {
             cout << "List is empty.\n";
@@ -275,6 +1522,128 @@ int main() {
     cout << "\nAttempting to pop from empty list:\n";
     lst.pop_front();
 
+    cout << "\nAttempting try_pop_end on empty list: "
+         << (lst.try_pop_end() ? "got a value" : "no value") << endl;
+
+    cout << "\nBulk operations on 1, 1, 2, 3, 3, 4, 5, 6:\n";
+    int values[] = { 1, 1, 2, 3, 3, 4, 5, 6 };
+    for (int n : values)
+        lst.push_end(n);
+    cout << "unique() removed " << lst.unique() << ": ";
+    lst.display();
+
+    DList evens;
+    lst.partition([](int n) { return n % 2 == 0; }, evens);
+    cout << "partition(even) left: ";
+    lst.display();
+    cout << "and moved: ";
+    evens.display_reverse();
+
+    cout << "remove_range(0, 2) removed " << evens.remove_range(0, 2) << ": ";
+    evens.display();
+    cout << "erase_if(> 0) removed " << lst.erase_if([](int n) { return n > 0; }) << ": ";
+    lst.display();
+
+    cout << "\nPositional operations on 10, 20, 30:\n";
+    lst.push_end(10);
+    lst.push_end(20);
+    lst.push_end(30);
+    lst.insert_at(1, 15);
+    lst.insert_at(3, 25);
+    lst.display();
+    cout << "at(3): " << lst.at(3) << ", erase_at(1): " << lst.erase_at(1) << endl;
+    lst.display();
+    cout << "try_at(10) has value? " << (lst.try_at(10) ? "Yes" : "No") << endl;
+    while (!lst.empty())
+        lst.pop_front();
+
+    cout << "\nExact value summary on 10, 20, 20, 30:\n";
+    lst.enable_summary(SUMMARY_EXACT);
+    lst.push_end(10);
+    lst.push_end(20);
+    lst.push_end(20);
+    lst.push_end(30);
+    cout << "count(20) without a walk: " << lst.count(20) << endl;
+    cout << "erase(99) returns at once: " << lst.erase(99) << endl;
+    SummaryStats stats = lst.summary_stats();
+    cout << "Summary: " << stats.lookups << " lookups, " << stats.ruled_out << " ruled out, "
+         << stats.memory_bytes << " bytes\n";
+    lst.enable_summary(SUMMARY_NONE);
+    while (!lst.empty())
+        lst.pop_front();
+
+    cout << "\nDumping the last 2 values in reverse:\n";
+    lst.push_end(60);
+    lst.push_end(70);
+    lst.push_end(80);
+    lst.dump_reverse(STDOUT_FILENO, DUMP_TEXT, 2, true);
+    while (!lst.empty())
+        lst.pop_front();
+
+    const int N = 4000000;
+    cout << "\nBuilding a list of " << N << " nodes for the parallel traversals:\n";
+    for (int i = 0; i < N; ++i)
+        lst.push_end(i % 1000);
+
+    auto start = chrono::steady_clock::now();
+    int serial = lst.count(7);
+    auto serial_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    lst.parallel_count(7);   // first call pays for the sampling walk
+    start = chrono::steady_clock::now();
+    int parallel = lst.parallel_count(7);
+    auto parallel_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "count(7): " << serial << " in " << serial_time << " ms\n";
+    cout << "parallel_count(7): " << parallel << " in " << parallel_time << " ms on "
+         << thread::hardware_concurrency() << " cores\n";
+
+    long long sum = lst.parallel_reduce(0LL,
+        [](long long acc, int value) { return acc + value; },
+        [](long long a, long long b) { return a + b; });
+    cout << "parallel_reduce sum: " << sum << endl;
+
+    lst.build_index();
+    const int LOOKUPS = 100000;
+    unsigned int seed = 12345;
+    start = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (int i = 0; i < LOOKUPS; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        checksum += lst.at((int)(seed % N));
+    }
+    auto at_time = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < LOOKUPS; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        int index = (int)(seed % N);
+        lst.insert_at(index, i);
+        checksum += lst.erase_at(index);
+    }
+    auto update_time = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+    cout << "Random at(i): " << at_time / LOOKUPS << " us, insert_at + erase_at: "
+         << update_time / LOOKUPS << " us (checksum " << checksum << ")\n";
+
+    // The index must not cost the O(1) ends: one push in four links a tower
+    // next to the index head or the level tails without a descent.
+    const int END_OPS = 5000000;
+    for (int indexed = 0; indexed < 2; ++indexed) {
+        DList queue;
+        if (indexed) queue.build_index();
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < END_OPS; ++i)
+            queue.push_end(i);
+        auto push_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        start = chrono::steady_clock::now();
+        while (!queue.empty())
+            checksum += queue.pop_front_unchecked();
+        auto pop_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << END_OPS << " push_end then pop_front " << (indexed ? "with" : "without")
+             << " the index: " << push_time << " + " << pop_time << " ms\n";
+    }
+
     cout << "\nProgram finished successfully.\n";
 
     return 0;
@@ -0,0 +1,378 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+using namespace std;
+
+const int MAX_SIZE = 100;
+const int MAX_THREADS = 64;
+const int COMBINE_PASSES = 4;    // passes a combiner makes before handing the lock back
+const int MAX_BACKOFF = 64;      // spin iterations a waiter tries before yielding
+
+class StaticStack {
+private:
+    int data[MAX_SIZE];
+    int top_index;
+
+public:
+    StaticStack() : top_index(-1) {}
+
+    bool empty() const { return top_index == -1; }
+    bool full() const { return top_index == MAX_SIZE - 1; }
+    int size() const { return top_index + 1; }
+
+    void push_unchecked(int n) { data[++top_index] = n; }
+
+    bool try_push(int n) {
+        if (full()) return false;
+        push_unchecked(n);
+        return true;
+    }
+
+    int pop_unchecked() { return data[top_index--]; }
+
+    optional<int> try_pop() {
+        if (empty()) return nullopt;
+        return pop_unchecked();
+    }
+};
+
+class DynamicStack {
+private:
+    int* data;
+    int capacity;
+    int top_index;
+
+    void resize() {
+        int new_capacity = (capacity == 0) ? 1 : capacity * 2;
+        int* new_data = new int[new_capacity];
+
+        for (int i = 0; i < capacity; ++i) {
+            new_data[i] = data[i];
+        }
+
+        delete[] data;
+        data = new_data;
+        capacity = new_capacity;
+    }
+
+public:
+    DynamicStack() : data(nullptr), capacity(0), top_index(-1) {}
+    ~DynamicStack() { delete[] data; }
+
+    bool empty() const { return top_index == -1; }
+    int size() const { return top_index + 1; }
+
+    void push(int n) {
+        if (size() == capacity) {
+            resize();
+        }
+        data[++top_index] = n;
+    }
+
+    int pop_unchecked() { return data[top_index--]; }
+
+    optional<int> try_pop() {
+        if (empty()) return nullopt;
+        return pop_unchecked();
+    }
+};
+
+// Lets the combiner push into either stack; only the static one can refuse.
+bool apply_push(StaticStack& s, int n) { return s.try_push(n); }
+bool apply_push(DynamicStack& s, int n) { s.push(n); return true; }
+
+// Every thread owns one publication slot while it is alive; the index is
+// handed back when the thread exits so short-lived threads do not run out.
+atomic<bool> slot_taken[MAX_THREADS];
+atomic<int> slot_limit(0);
+
+class ThreadSlot {
+private:
+    int slot_id;
+
+public:
+    ThreadSlot() : slot_id(-1) {
+        for (int i = 0; i < MAX_THREADS; ++i) {
+            if (!slot_taken[i].exchange(true)) {
+                slot_id = i;
+                break;
+            }
+        }
+        if (slot_id == -1)
+            throw overflow_error("Too many threads: no free combining slot.");
+
+        int limit = slot_limit.load();
+        while (limit < slot_id + 1 && !slot_limit.compare_exchange_weak(limit, slot_id + 1)) {}
+    }
+
+    ~ThreadSlot() { slot_taken[slot_id].store(false); }
+
+    int id() const { return slot_id; }
+};
+
+int my_slot() {
+    thread_local ThreadSlot slot;
+    return slot.id();
+}
+
+enum Operation { NONE = 0, PUSH = 1, POP = 2 };
+
+// One cache line per slot so publishing a request never false-shares.
+struct alignas(64) Request {
+    atomic<int> op;
+    int value;
+    bool ok;
+
+    Request() : op(NONE), value(0), ok(false) {}
+};
+
+// Flat combining: a thread publishes its request in its own slot, and whoever
+// takes the combiner lock serves every pending slot in one pass. Push/pop
+// pairs found in the same pass cancel out without touching the stack.
+template <typename Stack>
+class FlatCombiningStack {
+private:
+    Stack stack;
+    atomic<bool> combiner_lock;
+    Request slots[MAX_THREADS];
+
+    // One sweep over the publication slots; returns how many requests it served.
+    int combine_pass() {
+        int limit = slot_limit.load(memory_order_acquire);
+        int pushes[MAX_THREADS];
+        int pops[MAX_THREADS];
+        int push_count = 0;
+        int pop_count = 0;
+
+        for (int i = 0; i < limit; ++i) {
+            int op = slots[i].op.load(memory_order_acquire);
+            if (op == PUSH) pushes[push_count++] = i;
+            else if (op == POP) pops[pop_count++] = i;
+        }
+
+        // Elimination: hand each push's value straight to a waiting pop.
+        int pairs = (push_count < pop_count) ? push_count : pop_count;
+        for (int i = 0; i < pairs; ++i) {
+            Request& push_req = slots[pushes[push_count - 1 - i]];
+            Request& pop_req = slots[pops[pop_count - 1 - i]];
+            pop_req.value = push_req.value;
+            pop_req.ok = true;
+            push_req.ok = true;
+            pop_req.op.store(NONE, memory_order_release);
+            push_req.op.store(NONE, memory_order_release);
+        }
+
+        for (int i = 0; i < push_count - pairs; ++i) {
+            Request& req = slots[pushes[i]];
+            req.ok = apply_push(stack, req.value);
+            req.op.store(NONE, memory_order_release);
+        }
+
+        for (int i = 0; i < pop_count - pairs; ++i) {
+            Request& req = slots[pops[i]];
+            optional<int> value = stack.try_pop();
+            req.ok = value.has_value();
+            if (req.ok) req.value = *value;
+            req.op.store(NONE, memory_order_release);
+        }
+        return push_count + pop_count;
+    }
+
+    // A combiner sweeps again only while the last sweep served someone
+    // besides itself, and never more than COMBINE_PASSES times, so it does
+    // not spin over empty slots while the waiters sit behind it.
+    void combine() {
+        for (int pass = 0; pass < COMBINE_PASSES; ++pass) {
+            if (combine_pass() <= 1) break;
+        }
+    }
+
+    Request& submit(int op, int n) {
+        Request& req = slots[my_slot()];
+        req.value = n;
+        req.op.store(op, memory_order_release);
+
+        // While someone else combines, back off exponentially on our own slot
+        // before yielding, instead of hammering the combiner lock.
+        int backoff = 1;
+        while (req.op.load(memory_order_acquire) != NONE) {
+            if (!combiner_lock.load(memory_order_relaxed) &&
+                !combiner_lock.exchange(true, memory_order_acquire)) {
+                combine();
+                combiner_lock.store(false, memory_order_release);
+                backoff = 1;
+            }
+            else if (backoff < MAX_BACKOFF) {
+                for (int i = 0; i < backoff && req.op.load(memory_order_relaxed) != NONE; ++i) {}
+                backoff *= 2;
+            }
+            else {
+                this_thread::yield();
+            }
+        }
+        return req;
+    }
+
+public:
+    FlatCombiningStack() : combiner_lock(false) {}
+
+    bool try_push(int n) {
+        return submit(PUSH, n).ok;
+    }
+
+    optional<int> try_pop() {
+        Request& req = submit(POP, 0);
+        if (!req.ok) return nullopt;
+        return req.value;
+    }
+
+    // Only meaningful while no other thread is using the stack.
+    int size() const { return stack.size(); }
+};
+
+// Baseline: the same stack behind one mutex.
+template <typename Stack>
+class MutexStack {
+private:
+    Stack stack;
+    mutex stack_mutex;
+
+public:
+    bool try_push(int n) {
+        lock_guard<mutex> guard(stack_mutex);
+        return apply_push(stack, n);
+    }
+
+    optional<int> try_pop() {
+        lock_guard<mutex> guard(stack_mutex);
+        return stack.try_pop();
+    }
+};
+
+// The link is atomic because a racing pop may read it while the node is being
+// moved onto the retired list.
+class LockFreeNode {
+private:
+    int value;
+    atomic<LockFreeNode*> next_node;
+
+public:
+    LockFreeNode(int val = 0, LockFreeNode* next = nullptr)
+        : value(val), next_node(next) {}
+
+    int retrieve() const { return value; }
+    LockFreeNode* next() const { return next_node.load(memory_order_relaxed); }
+    void set_next(LockFreeNode* next) { next_node.store(next, memory_order_relaxed); }
+};
+
+// Baseline: Treiber lock-free linked stack. Popped nodes are parked on a
+// retired list instead of freed, so an address is never reused (no ABA)
+// while threads are still running.
+class LockFreeStack {
+private:
+    atomic<LockFreeNode*> list_head;
+    atomic<LockFreeNode*> retired;
+
+    static void free_chain(LockFreeNode* ptr) {
+        while (ptr != nullptr) {
+            LockFreeNode* temp = ptr;
+            ptr = ptr->next();
+            delete temp;
+        }
+    }
+
+public:
+    LockFreeStack() : list_head(nullptr), retired(nullptr) {}
+
+    ~LockFreeStack() {
+        free_chain(list_head.load());
+        free_chain(retired.load());
+    }
+
+    bool try_push(int n) {
+        LockFreeNode* new_node = new LockFreeNode(n, list_head.load(memory_order_relaxed));
+        LockFreeNode* expected = new_node->next();
+        while (!list_head.compare_exchange_weak(expected, new_node,
+                                                memory_order_release, memory_order_relaxed))
+            new_node->set_next(expected);
+        return true;
+    }
+
+    optional<int> try_pop() {
+        LockFreeNode* old_head = list_head.load(memory_order_acquire);
+        while (old_head != nullptr &&
+               !list_head.compare_exchange_weak(old_head, old_head->next(),
+                                                memory_order_acquire, memory_order_acquire)) {}
+        if (old_head == nullptr) return nullopt;
+
+        int value = old_head->retrieve();
+        LockFreeNode* expected = retired.load(memory_order_relaxed);
+        do {
+            old_head->set_next(expected);
+        } while (!retired.compare_exchange_weak(expected, old_head,
+                                                memory_order_release, memory_order_relaxed));
+        return value;
+    }
+};
+
+// Each thread alternates push/pop, which keeps the static stack from filling
+// up and gives the combiner plenty of pairs to eliminate.
+template <typename Stack>
+double run_benchmark(int thread_count, int ops_per_thread) {
+    Stack stack;
+    vector<thread> threads;
+    atomic<long long> checksum(0);
+
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&stack, &checksum, t, ops_per_thread]() {
+            long long local_sum = 0;
+            for (int i = 0; i < ops_per_thread; ++i) {
+                stack.try_push(t * ops_per_thread + i);
+                optional<int> value = stack.try_pop();
+                if (value) local_sum += *value;
+            }
+            checksum += local_sum;
+        });
+    }
+    for (thread& th : threads)
+        th.join();
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    return (2.0 * thread_count * ops_per_thread) / ms / 1000.0;   // million ops per second
+}
+
+int main() {
+    FlatCombiningStack<StaticStack> s;
+
+    cout << "Pushing 10, 20, 30 through the combiner:\n";
+    s.try_push(10);
+    s.try_push(20);
+    s.try_push(30);
+    cout << "Size: " << s.size() << endl;
+    cout << "Popped: " << *s.try_pop() << endl;
+    cout << "Popped: " << *s.try_pop() << endl;
+    cout << "Popped: " << *s.try_pop() << endl;
+    cout << "try_pop on empty stack has value? " << (s.try_pop() ? "Yes" : "No") << endl;
+
+    const int OPS = 200000;
+    cout << "\nMillion ops/s (push+pop pairs, " << OPS << " pairs per thread):\n";
+    cout << "threads\tFC static\tFC dynamic\tmutex static\tmutex dynamic\tlock-free\n";
+    for (int threads = 1; threads <= 32; threads *= 2) {
+        cout << threads
+             << "\t" << run_benchmark<FlatCombiningStack<StaticStack>>(threads, OPS)
+             << "\t\t" << run_benchmark<FlatCombiningStack<DynamicStack>>(threads, OPS)
+             << "\t\t" << run_benchmark<MutexStack<StaticStack>>(threads, OPS)
+             << "\t\t" << run_benchmark<MutexStack<DynamicStack>>(threads, OPS)
+             << "\t\t" << run_benchmark<LockFreeStack>(threads, OPS) << endl;
+    }
+
+    cout << "\nProgram finished successfully.\n";
+
+    return 0;
+}
@@ -0,0 +1,554 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+using namespace std;
+
+const int CACHE_LINE = 64;
+
+// Copy of DynamicStack from stack with dynamic array.cpp, used here as plain
+// growable storage: its buffer is cache-line aligned, grows with memcpy, and
+// gives direct access to the ints.
+class DynamicStack {
+private:
+    int* data;
+    int capacity;
+    int top_index;
+
+    static int* allocate(int n) {
+        return static_cast<int*>(::operator new[](n * sizeof(int), align_val_t(CACHE_LINE)));
+    }
+
+    static void release(int* p) {
+        ::operator delete[](p, align_val_t(CACHE_LINE));
+    }
+
+    void resize(int min_capacity) {
+        int new_capacity = (capacity == 0) ? 16 : capacity * 2;
+        while (new_capacity < min_capacity)
+            new_capacity *= 2;
+        int* new_data = allocate(new_capacity);
+
+        if (size() > 0) memcpy(new_data, data, size() * sizeof(int));
+
+        if (data != nullptr) release(data);
+        data = new_data;
+        capacity = new_capacity;
+    }
+
+public:
+    DynamicStack() : data(nullptr), capacity(0), top_index(-1) {}
+    ~DynamicStack() { if (data != nullptr) release(data); }
+
+    DynamicStack(const DynamicStack&) = delete;
+    DynamicStack& operator=(const DynamicStack&) = delete;
+
+    bool empty() const { return top_index == -1; }
+    int size() const { return top_index + 1; }
+
+    void push(int n) {
+        if (size() == capacity) {
+            resize(size() + 1);
+        }
+        data[++top_index] = n;
+    }
+
+    int pop_unchecked() { return data[top_index--]; }
+
+    // Grows or shrinks the logical size; new slots are uninitialized.
+    void set_size(int n) {
+        if (n > capacity) resize(n);
+        top_index = n - 1;
+    }
+
+    int* begin() { return data; }
+    const int* begin() const { return data; }
+};
+
+// Min-priority queue as a 4-ary heap on DynamicStack storage. The keys live
+// in their own array, which starts with eleven unused ints, so the four
+// children of any node (heap positions 4p+1 .. 4p+4) are 16 aligned bytes and
+// its sixteen grandchildren fill exactly one cache line: a sift-down level
+// costs at most one line, and plain push()/pop() move nothing but keys.
+//
+// push_with_handle() returns a handle for decrease_key() and key_of(). The
+// first one switches on a side array that records each position's handle
+// slot; it then moves along with the keys until heapify() clears the
+// handles. A handle packs a slot number (low 32 bits) with that slot's
+// generation, which is bumped when the slot is freed, so a handle to a popped
+// entry stays rejected after its slot is reused by a later push.
+class QuadHeap {
+private:
+    static const int PAD = 11;
+    static const int NO_HANDLE = -1;
+
+    DynamicStack keys;            // PAD + heap position -> key
+    DynamicStack slots;           // PAD + heap position -> handle slot, while tracking
+    DynamicStack handle_slot;     // slot -> heap position, -1 when free
+    DynamicStack slot_generation; // slot -> generation, 31 bits so handles stay >= 0
+    DynamicStack free_handles;
+    int count;
+    bool tracking;                // slots is kept in step with keys
+
+    int& key_at(int p) { return keys.begin()[PAD + p]; }
+    int key_at(int p) const { return keys.begin()[PAD + p]; }
+    int& slot_at(int p) { return slots.begin()[PAD + p]; }
+
+    template <bool TRACK>
+    void place(int p, int k, int h) {
+        key_at(p) = k;
+        if (TRACK) {
+            slot_at(p) = h;
+            if (h != NO_HANDLE) handle_slot.begin()[h] = p;
+        }
+    }
+
+    // Moves a hole up from p instead of swapping at every level.
+    template <bool TRACK>
+    void sift_up(int p, int k, int h) {
+        while (p > 0) {
+            int parent = (p - 1) / 4;
+            int parent_key = key_at(parent);
+            if (parent_key <= k) break;
+            place<TRACK>(p, parent_key, TRACK ? slot_at(parent) : NO_HANDLE);
+            p = parent;
+        }
+        place<TRACK>(p, k, h);
+    }
+
+    template <bool TRACK>
+    void sift_down(int p, int k, int h) {
+        const int* key = keys.begin() + PAD;
+        while (true) {
+            int first = 4 * p + 1;
+            if (first >= count) break;
+
+            const int* child = key + first;
+            int best = 0;
+            int last = (count - first < 4) ? count - first : 4;
+            for (int i = 1; i < last; ++i) {
+                if (child[i] < child[best]) best = i;
+            }
+            if (child[best] >= k) break;
+
+            place<TRACK>(p, child[best], TRACK ? slot_at(first + best) : NO_HANDLE);
+            p = first + best;
+        }
+        place<TRACK>(p, k, h);
+    }
+
+    // After a pop the root gets the last leaf's key, which almost always
+    // belongs near the bottom again: walk the hole down along the smaller
+    // children without comparing against it, then sift the key back up.
+    template <bool TRACK>
+    void refill_root(int k, int h) {
+        const int* key = keys.begin() + PAD;
+        int p = 0;
+        while (true) {
+            int first = 4 * p + 1;
+            if (first >= count) break;
+
+            // All sixteen grandchildren share one line; start loading it
+            // while this level's children are compared.
+            if (16 * p + 5 < count) __builtin_prefetch(key + 16 * p + 5);
+
+            const int* child = key + first;
+            int best = 0;
+            int last = (count - first < 4) ? count - first : 4;
+            for (int i = 1; i < last; ++i) {
+                if (child[i] < child[best]) best = i;
+            }
+
+            place<TRACK>(p, child[best], TRACK ? slot_at(first + best) : NO_HANDLE);
+            p = first + best;
+        }
+        sift_up<TRACK>(p, k, h);
+    }
+
+    void sift_up(int p, int k, int h) {
+        if (tracking) sift_up<true>(p, k, h);
+        else sift_up<false>(p, k, h);
+    }
+
+    void sift_down(int p, int k, int h) {
+        if (tracking) sift_down<true>(p, k, h);
+        else sift_down<false>(p, k, h);
+    }
+
+    // Floyd's bottom-up build over positions [0, count).
+    void build() {
+        for (int p = (count - 2) / 4; p >= 0 && count > 1; --p)
+            sift_down(p, key_at(p), tracking ? slot_at(p) : NO_HANDLE);
+    }
+
+    void grow_to(int n) {
+        keys.set_size(PAD + n);
+        if (tracking) slots.set_size(PAD + n);
+    }
+
+    // The entries already in the heap have no handle.
+    void start_tracking() {
+        if (tracking) return;
+        tracking = true;
+        slots.set_size(PAD + count);
+        for (int p = 0; p < count; ++p)
+            slot_at(p) = NO_HANDLE;
+    }
+
+    int new_handle() {
+        start_tracking();
+        if (!free_handles.empty()) return free_handles.pop_unchecked();
+        handle_slot.push(-1);
+        slot_generation.push(0);
+        return handle_slot.size() - 1;
+    }
+
+    void free_handle(int h) {
+        handle_slot.begin()[h] = -1;
+        slot_generation.begin()[h] = (slot_generation.begin()[h] + 1) & 0x7FFFFFFF;
+        free_handles.push(h);
+    }
+
+    long long make_handle(int h) const {
+        return ((long long)slot_generation.begin()[h] << 32) | (unsigned int)h;
+    }
+
+    // Slot behind a handle that passed check_handle().
+    static int slot_of(long long handle) {
+        return (int)(handle & 0xFFFFFFFF);
+    }
+
+    void check_handle(long long handle) const {
+        if (!contains(handle)) {
+            throw invalid_argument("Unknown or stale priority queue handle");
+        }
+    }
+
+public:
+    QuadHeap() : count(0), tracking(false) {
+        grow_to(0);
+    }
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+
+    // False once the entry behind handle has been popped, even if its slot
+    // now belongs to another entry.
+    bool contains(long long handle) const {
+        if (handle < 0) return false;
+        long long h = handle & 0xFFFFFFFF;
+        return h < handle_slot.size() && handle_slot.begin()[h] != -1 &&
+               slot_generation.begin()[h] == (int)(handle >> 32);
+    }
+
+    void push(int k) {
+        grow_to(count + 1);
+        sift_up(count++, k, NO_HANDLE);
+    }
+
+    long long push_with_handle(int k) {
+        int h = new_handle();
+        grow_to(count + 1);
+        sift_up<true>(count++, k, h);
+        return make_handle(h);
+    }
+
+    // Appends n keys; with handles_out, each gets a handle written there. A
+    // batch that is large next to the heap is appended as is and the heap
+    // rebuilt in O(size); a small one is sifted up key by key.
+    void push_batch(const int* values, int n, long long* handles_out = nullptr) {
+        if (n <= 0) return;
+        if (handles_out != nullptr) start_tracking();
+        bool rebuild = (n > count / 2);
+        int first = count;
+        grow_to(count + n);
+
+        for (int i = 0; i < n; ++i) {
+            int h = NO_HANDLE;
+            if (handles_out != nullptr) {
+                h = new_handle();
+                handles_out[i] = make_handle(h);
+            }
+            if (!rebuild) sift_up(count++, values[i], h);
+            else if (tracking) place<true>(first + i, values[i], h);
+            else key_at(first + i) = values[i];
+        }
+
+        if (rebuild) {
+            count = first + n;
+            build();
+        }
+    }
+
+    // Replaces the contents with values[0 .. n) in O(n). Earlier handles
+    // become invalid.
+    void heapify(const int* values, int n) {
+        for (int h = 0; h < handle_slot.size(); ++h) {
+            if (handle_slot.begin()[h] != -1) free_handle(h);
+        }
+        tracking = false;
+
+        count = n;
+        grow_to(n);
+        if (n > 0) memcpy(&key_at(0), values, n * sizeof(int));
+        build();
+    }
+
+    // Unchecked variants: the caller guarantees the queue is not empty.
+    int top_unchecked() const { return key_at(0); }
+
+    int pop_unchecked() {
+        int k = key_at(0);
+        if (tracking && slot_at(0) != NO_HANDLE) free_handle(slot_at(0));
+
+        --count;
+        if (count > 0) {
+            if (tracking) refill_root<true>(key_at(count), slot_at(count));
+            else refill_root<false>(key_at(count), NO_HANDLE);
+        }
+        grow_to(count);
+        return k;
+    }
+
+    int top() const {
+        if (empty()) {
+            throw out_of_range("Top on empty priority queue");
+        }
+        return top_unchecked();
+    }
+
+    int pop() {
+        if (empty()) {
+            throw out_of_range("Pop on empty priority queue");
+        }
+        return pop_unchecked();
+    }
+
+    optional<int> try_top() const {
+        if (empty()) return nullopt;
+        return top_unchecked();
+    }
+
+    optional<int> try_pop() {
+        if (empty()) return nullopt;
+        return pop_unchecked();
+    }
+
+    int key_of(long long handle) const {
+        check_handle(handle);
+        return key_at(handle_slot.begin()[slot_of(handle)]);
+    }
+
+    void decrease_key(long long handle, int new_key) {
+        check_handle(handle);
+        int h = slot_of(handle);
+        int p = handle_slot.begin()[h];
+        if (new_key > key_at(p)) {
+            throw invalid_argument("decrease_key cannot raise a key");
+        }
+        sift_up<true>(p, new_key, h);
+    }
+
+    void display() const {
+        if (empty()) {
+            cout << "Priority queue is empty.\n";
+            return;
+        }
+
+        cout << "TOP -> ";
+        for (int p = 0; p < count; ++p)
+            cout << key_at(p) << (p + 1 < count ? " " : "");
+        cout << " (heap order)\n";
+    }
+};
+
+// The approach being replaced: a DList kept sorted by walking to each key's
+// place. Cut down to what the benchmark needs.
+class DNode {
+private:
+    int value;
+    DNode* next_node;
+    DNode* prev_node;
+
+public:
+    DNode(int val = 0, DNode* next = nullptr, DNode* prev = nullptr)
+        : value(val), next_node(next), prev_node(prev) {}
+
+    int retrieve() const { return value; }
+    DNode* next() const { return next_node; }
+    DNode* prev() const { return prev_node; }
+    void set_next(DNode* next) { next_node = next; }
+    void set_prev(DNode* prev) { prev_node = prev; }
+};
+
+class SortedDList {
+private:
+    DNode* list_head;
+    DNode* list_tail;
+
+public:
+    SortedDList() : list_head(nullptr), list_tail(nullptr) {}
+
+    ~SortedDList() {
+        while (list_head != nullptr)
+            pop_front();
+    }
+
+    void insert(int n) {
+        DNode* ptr = list_head;
+        while (ptr != nullptr && ptr->retrieve() <= n)
+            ptr = ptr->next();
+
+        DNode* before = (ptr != nullptr) ? ptr->prev() : list_tail;
+        DNode* new_node = new DNode(n, ptr, before);
+        if (before != nullptr) before->set_next(new_node);
+        else list_head = new_node;
+        if (ptr != nullptr) ptr->set_prev(new_node);
+        else list_tail = new_node;
+    }
+
+    int pop_front() {
+        DNode* temp = list_head;
+        int value = temp->retrieve();
+        list_head = list_head->next();
+        if (list_head == nullptr) list_tail = nullptr;
+        else list_head->set_prev(nullptr);
+        delete temp;
+        return value;
+    }
+};
+
+volatile long long benchmark_sink;   // keeps the benchmark loops from being optimized away
+
+const int SORTED_DLIST_LIMIT = 10000;   // O(n^2) build; larger sizes would run for hours
+
+// Push n pseudo-random keys one by one, then pop them all. Returns ms.
+template <typename PushFunc, typename PopFunc>
+double push_pop_benchmark(int n, PushFunc push, PopFunc pop) {
+    unsigned int seed = 12345;
+    long long checksum = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        push((int)(seed >> 1));
+    }
+    for (int i = 0; i < n; ++i)
+        checksum += pop();
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    benchmark_sink = checksum;
+    return ms;
+}
+
+int main(int argc, char** argv) {
+    QuadHeap pq;
+
+    cout << "Pushing 50, 20, 40, 10, 30:\n";
+    pq.push(50);
+    long long h20 = pq.push_with_handle(20);
+    pq.push(40);
+    pq.push(10);
+    long long h30 = pq.push_with_handle(30);
+    pq.display();
+
+    cout << "Top: " << pq.top() << endl;
+    cout << "decrease_key(30 -> 5), top is now: ";
+    pq.decrease_key(h30, 5);
+    cout << pq.top() << endl;
+    cout << "Key behind the handle for 20: " << pq.key_of(h20) << endl;
+
+    cout << "Popping all:";
+    while (optional<int> value = pq.try_pop())
+        cout << " " << *value;
+    cout << endl;
+
+    long long h60 = pq.push_with_handle(60);   // reuses the slot h20 had
+    cout << "Handle for 20 after it was popped still valid? " << (pq.contains(h20) ? "Yes" : "No") << endl;
+    try {
+        pq.decrease_key(h20, 1);
+    } catch (const invalid_argument& e) {
+        cout << "decrease_key on it: " << e.what() << ", key behind the new handle still " << pq.key_of(h60) << endl;
+    }
+    pq.pop();
+
+    int batch[] = { 9, 3, 7, 1, 8, 2 };
+    pq.heapify(batch, 6);
+    int more[] = { 6, 0 };
+    pq.push_batch(more, 2);
+    cout << "heapify(9 3 7 1 8 2) + push_batch(6 0), popping:";
+    while (!pq.empty())
+        cout << " " << pq.pop();
+    cout << endl;
+
+    try {
+        pq.pop();
+    } catch (const out_of_range& e) {
+        cout << "Pop on empty queue: " << e.what() << endl;
+    }
+
+    // Pass the largest power of ten to run as the first argument (up to 8;
+    // 10^8 needs about 1.5 GB).
+    int max_exponent = (argc > 1) ? atoi(argv[1]) : 6;
+    if (max_exponent > 8) max_exponent = 8;
+
+    cout << "\nPush n random keys, then pop all (ms):\n";
+    cout << "n\t\tQuadHeap\twith handles\tpriority_queue\theapify+pop\tsorted DList\n";
+    for (int e = 3, n = 1000; e <= max_exponent; ++e, n *= 10) {
+        double quad_ms;
+        {
+            QuadHeap heap;
+            quad_ms = push_pop_benchmark(n, [&heap](int k) { heap.push(k); },
+                                         [&heap]() { return heap.pop_unchecked(); });
+        }
+
+        double handle_ms;
+        {
+            QuadHeap heap;
+            handle_ms = push_pop_benchmark(n, [&heap](int k) { heap.push_with_handle(k); },
+                                           [&heap]() { return heap.pop_unchecked(); });
+        }
+
+        double std_ms;
+        {
+            priority_queue<int, vector<int>, greater<int>> heap;
+            std_ms = push_pop_benchmark(n, [&heap](int k) { heap.push(k); },
+                                        [&heap]() { int k = heap.top(); heap.pop(); return k; });
+        }
+
+        double heapify_ms;
+        {
+            QuadHeap heap;
+            vector<int> values;
+            values.reserve(n);
+            heapify_ms = push_pop_benchmark(n, [&values](int k) { values.push_back(k); },
+                                            [&heap, &values]() {
+                                                if (!values.empty()) {
+                                                    heap.heapify(values.data(), (int)values.size());
+                                                    values.clear();
+                                                }
+                                                return heap.pop_unchecked();
+                                            });
+        }
+
+        cout << n << (n < 10000000 ? "\t\t" : "\t") << quad_ms << "\t\t" << handle_ms << "\t\t" << std_ms << "\t\t" << heapify_ms << "\t\t";
+        if (n <= SORTED_DLIST_LIMIT) {
+            SortedDList sorted;
+            cout << push_pop_benchmark(n, [&sorted](int k) { sorted.insert(k); },
+                                       [&sorted]() { return sorted.pop_front(); });
+        }
+        else {
+            cout << "skipped (O(n^2))";
+        }
+        cout << endl;
+    }
+
+    cout << "\nProgram finished successfully.\n";
+
+    return 0;
+}
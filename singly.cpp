@@ -1,6 +1,362 @@
 #include <iostream>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <fcntl.h>
+#include <unistd.h>
 using namespace std;
 
+// Misuse reporting lives out of line so the checked accessors inline to a few
+// instructions at each call site. Build with -DNO_ERROR_LOG to silence it.
+[[gnu::cold, gnu::noinline]] void log_error([[maybe_unused]] const char* msg) {
+#ifndef NO_ERROR_LOG
+    cerr << msg;
+#endif
+}
+
+[[gnu::cold, gnu::noinline]] void log_index_error([[maybe_unused]] int max_index) {
+#ifndef NO_ERROR_LOG
+    cerr << "Invalid index! Must be between 0 and " << max_index << ".\n";
+#endif
+}
+
+enum DumpFormat { DUMP_TEXT, DUMP_CSV, DUMP_BINARY };
+
+// Formats values with to_chars into one large buffer and hands it to write()
+// in big pieces, instead of one operator<< per element like display().
+class DumpWriter {
+private:
+    static const int BUFFER_SIZE = 1 << 16;
+    char buffer[BUFFER_SIZE];
+    int used;
+    int fd;
+    DumpFormat format;
+    const char* separator;
+    bool first_item;
+    bool failed;
+
+    // Retries partial writes and EINTR. Any other error, or a write that makes
+    // no progress, marks the writer failed and drops everything after it.
+    void flush() {
+        int done = 0;
+        while (done < used && !failed) {
+            ssize_t n = write(fd, buffer + done, used - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) failed = true;
+            else done += (int)n;
+        }
+        used = 0;
+    }
+
+    void put(const char* s, int len) {
+        if (used + len > BUFFER_SIZE) flush();
+        memcpy(buffer + used, s, len);
+        used += len;
+    }
+
+    void put(const char* s) { put(s, (int)strlen(s)); }
+
+    void next_item() {
+        if (!first_item) put(separator);
+        first_item = false;
+    }
+
+public:
+    DumpWriter(int out_fd, DumpFormat fmt)
+        : used(0), fd(out_fd), format(fmt), separator(","), first_item(true), failed(false) {
+        if (fd == STDOUT_FILENO) cout.flush();   // keep ordering with earlier cout output
+    }
+
+    ~DumpWriter() { flush(); }
+
+    // Writes out what is buffered; false if any of the output was lost.
+    bool finish() {
+        flush();
+        return !failed;
+    }
+
+    void text(const char* s) {
+        if (format == DUMP_TEXT) put(s);
+    }
+
+    void text_value(int n) {
+        if (format != DUMP_TEXT) return;
+        if (used + 11 > BUFFER_SIZE) flush();
+        used = (int)(to_chars(buffer + used, buffer + BUFFER_SIZE, n).ptr - buffer);
+    }
+
+    void open(const char* prefix, const char* text_separator) {
+        if (format == DUMP_TEXT) separator = text_separator;
+        text(prefix);
+    }
+
+    void value(int n) {
+        if (format == DUMP_BINARY) {
+            put((const char*)&n, (int)sizeof(n));
+            return;
+        }
+        next_item();
+        if (used + 11 > BUFFER_SIZE) flush();
+        used = (int)(to_chars(buffer + used, buffer + BUFFER_SIZE, n).ptr - buffer);
+    }
+
+    // Marks values cut off by a first/last N limit.
+    void omitted() {
+        if (format != DUMP_TEXT) return;
+        next_item();
+        put("...");
+    }
+
+    void close(const char* suffix) {
+        if (format == DUMP_TEXT) put(suffix);
+        else if (format == DUMP_CSV) put("\n");
+    }
+};
+
+// Flushes a dump and reports a write that did not go through.
+bool finish_dump(DumpWriter& out) {
+    if (out.finish()) return true;
+    log_error("Dump failed! Could not write to the file descriptor.\n");
+    return false;
+}
+
+enum SummaryMode { SUMMARY_NONE, SUMMARY_EXACT, SUMMARY_BLOOM };
+
+struct SummaryStats {
+    SummaryMode mode;
+    long long memory_bytes;         // heap bytes held by the summary
+    long long lookups;              // count/erase calls that consulted it
+    long long ruled_out;            // lookups that proved the value absent, no walk
+    long long false_positives;      // Bloom said "maybe", the walk found nothing
+    double false_positive_rate;     // measured, over lookups of absent values
+    double expected_false_positive_rate;
+};
+
+// Optional companion to a list that knows which values it holds, so count()
+// and erase() can answer without a walk. SUMMARY_EXACT keeps a hash multiset
+// (value -> occurrences, open addressing) and answers count() in O(1).
+// SUMMARY_BLOOM keeps a counting Bloom filter of a fixed number of one-byte
+// counters: it only rules values out, but costs one byte per counter however
+// many values the list holds. A counter that reaches 255 sticks there, since
+// it can no longer tell how many values share it.
+class ValueSummary {
+private:
+    static const int BLOOM_HASHES = 4;
+
+    SummaryMode mode;
+    int* keys;
+    int* counts;                // 0 marks an empty slot
+    int table_capacity;
+    int table_used;
+    unsigned char* counters;
+    int counter_count;
+    int counters_in_use;
+    // Statistics only: lookups come from const count() calls that may run
+    // concurrently, so these are relaxed atomic counters.
+    mutable atomic<long long> lookups;
+    mutable atomic<long long> ruled_out;
+    mutable atomic<long long> false_positives;
+
+    static void bump(atomic<long long>& counter) {
+        counter.fetch_add(1, memory_order_relaxed);
+    }
+
+    static unsigned int mix(unsigned int x) {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    int find_slot(int n) const {
+        int mask = table_capacity - 1;
+        int slot = mix((unsigned int)n) & mask;
+        while (counts[slot] != 0 && keys[slot] != n)
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void grow_table() {
+        int* old_keys = keys;
+        int* old_counts = counts;
+        int old_capacity = table_capacity;
+
+        table_capacity = (old_capacity == 0) ? 16 : old_capacity * 2;
+        keys = new int[table_capacity];
+        counts = new int[table_capacity]();
+        for (int i = 0; i < old_capacity; ++i) {
+            if (old_counts[i] != 0) {
+                int slot = find_slot(old_keys[i]);
+                keys[slot] = old_keys[i];
+                counts[slot] = old_counts[i];
+            }
+        }
+
+        delete[] old_keys;
+        delete[] old_counts;
+    }
+
+    // Backward-shift deletion: pull later entries of the probe run into the
+    // hole, so lookups never need tombstones.
+    void remove_slot(int hole) {
+        int mask = table_capacity - 1;
+        int i = hole;
+        for (int j = (i + 1) & mask; counts[j] != 0; j = (j + 1) & mask) {
+            int home = mix((unsigned int)keys[j]) & mask;
+            bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (!stays) {
+                keys[i] = keys[j];
+                counts[i] = counts[j];
+                i = j;
+            }
+        }
+        counts[i] = 0;
+        --table_used;
+    }
+
+    void bloom_positions(int n, int* positions) const {
+        unsigned int h1 = mix((unsigned int)n);
+        unsigned int h2 = mix(h1 ^ 0x9e3779b9u) | 1;
+        for (int i = 0; i < BLOOM_HASHES; ++i)
+            positions[i] = (int)((h1 + i * h2) & (unsigned int)(counter_count - 1));
+    }
+
+    void release() {
+        delete[] keys;
+        delete[] counts;
+        delete[] counters;
+        keys = counts = nullptr;
+        counters = nullptr;
+        table_capacity = table_used = 0;
+        counter_count = counters_in_use = 0;
+    }
+
+public:
+    ValueSummary()
+        : mode(SUMMARY_NONE), keys(nullptr), counts(nullptr), table_capacity(0), table_used(0),
+          counters(nullptr), counter_count(0), counters_in_use(0),
+          lookups(0), ruled_out(0), false_positives(0) {}
+
+    ~ValueSummary() { release(); }
+
+    ValueSummary(const ValueSummary&) = delete;
+    ValueSummary& operator=(const ValueSummary&) = delete;
+
+    // Starts an empty summary; the owner adds its current values afterwards.
+    // bloom_counters is rounded up to a power of two.
+    void reset(SummaryMode new_mode, int bloom_counters) {
+        release();
+        mode = new_mode;
+        lookups.store(0, memory_order_relaxed);
+        ruled_out.store(0, memory_order_relaxed);
+        false_positives.store(0, memory_order_relaxed);
+        if (mode == SUMMARY_EXACT) {
+            grow_table();
+        }
+        else if (mode == SUMMARY_BLOOM) {
+            counter_count = 64;
+            while (counter_count < bloom_counters)
+                counter_count *= 2;
+            counters = new unsigned char[counter_count]();
+        }
+    }
+
+    void add(int n) {
+        if (mode == SUMMARY_EXACT) {
+            if (2 * (table_used + 1) > table_capacity)
+                grow_table();
+            int slot = find_slot(n);
+            if (counts[slot] == 0) {
+                keys[slot] = n;
+                ++table_used;
+            }
+            ++counts[slot];
+        }
+        else if (mode == SUMMARY_BLOOM) {
+            int positions[BLOOM_HASHES];
+            bloom_positions(n, positions);
+            for (int p : positions) {
+                if (counters[p] == 0) ++counters_in_use;
+                if (counters[p] != 255) ++counters[p];
+            }
+        }
+    }
+
+    void remove(int n) {
+        if (mode == SUMMARY_EXACT) {
+            int slot = find_slot(n);
+            if (counts[slot] != 0 && --counts[slot] == 0)
+                remove_slot(slot);
+        }
+        else if (mode == SUMMARY_BLOOM) {
+            int positions[BLOOM_HASHES];
+            bloom_positions(n, positions);
+            for (int p : positions) {
+                if (counters[p] != 0 && counters[p] != 255 && --counters[p] == 0)
+                    --counters_in_use;
+            }
+        }
+    }
+
+    bool enabled() const { return mode != SUMMARY_NONE; }
+
+    // Occurrences of n if the summary knows them, 0 if n is certainly
+    // absent, or -1 when the caller has to walk the list.
+    int lookup(int n) const {
+        if (mode == SUMMARY_NONE) return -1;
+        bump(lookups);
+
+        if (mode == SUMMARY_EXACT) {
+            int found = counts[find_slot(n)];
+            if (found == 0) bump(ruled_out);
+            return found;
+        }
+
+        int positions[BLOOM_HASHES];
+        bloom_positions(n, positions);
+        for (int p : positions) {
+            if (counters[p] == 0) {
+                bump(ruled_out);
+                return 0;
+            }
+        }
+        return -1;
+    }
+
+    // Reports the result of a walk that lookup() asked for.
+    void note_scan(int found) const {
+        if (mode == SUMMARY_BLOOM && found == 0)
+            bump(false_positives);
+    }
+
+    SummaryStats stats() const {
+        SummaryStats s;
+        s.mode = mode;
+        s.memory_bytes = (long long)table_capacity * 2 * sizeof(int) + counter_count;
+        s.lookups = lookups.load(memory_order_relaxed);
+        s.ruled_out = ruled_out.load(memory_order_relaxed);
+        s.false_positives = false_positives.load(memory_order_relaxed);
+
+        long long absent = (mode == SUMMARY_BLOOM) ? s.ruled_out + s.false_positives : 0;
+        s.false_positive_rate = (absent > 0) ? (double)s.false_positives / absent : 0.0;
+
+        double expected = 0.0;
+        if (mode == SUMMARY_BLOOM) {
+            double fill = (double)counters_in_use / counter_count;
+            expected = 1.0;
+            for (int i = 0; i < BLOOM_HASHES; ++i)
+                expected *= fill;
+        }
+        s.expected_false_positive_rate = expected;
+        return s;
+    }
+};
+
 class Node {
 private:
     int value;         
@@ -23,13 +379,108 @@ public:
 class List {
 private:
     Node* list_head;  
+    Node* list_tail;
+    int list_size;
+    ValueSummary summary;
+
+    // The last node reached by position, so push_between(i), push_between(i + 1),
+    // ... walk one step each instead of from the head. finger_node == nullptr
+    // means unset.
+    Node* finger_node;
+    int finger_index;
+
+    void reset_finger() {
+        finger_node = nullptr;
+    }
+
+    // Node at index (0 <= index < size), starting from the finger when it is
+    // not past index. Leaves the finger there.
+    Node* node_at(int index) {
+        Node* ptr = list_head;
+        int i = 0;
+        if (finger_node != nullptr && finger_index <= index) {
+            ptr = finger_node;
+            i = finger_index;
+        }
+        for (; i < index; ++i)
+            ptr = ptr->next();
+
+        finger_node = ptr;
+        finger_index = index;
+        return ptr;
+    }
+
+    // Bulk operations unlink first and free everything here in one go.
+    static void free_chain(Node* ptr) {
+        while (ptr != nullptr) {
+            Node* temp = ptr;
+            ptr = ptr->next();
+            delete temp;
+        }
+    }
 
 public:
 
-    List() : list_head(nullptr) {}
+    List() : list_head(nullptr), list_tail(nullptr), list_size(0), finger_node(nullptr), finger_index(0) {}
     ~List() {
-        while (!empty())
-            pop_front();  // delete first node repeatedly
+        free_chain(list_head);
+    }
+
+    // Builder mode: appends a stream of values keeping only its own tail, and
+    // settles the list's tail, size and summary once in finish() (or the
+    // destructor). It holds a plain List&, so it must not outlive the list.
+    // Pushed values are not in the list until finish(), which links them
+    // after whatever the tail is at that moment: do not mix builder pushes
+    // with other mutations of the list, or finish() first.
+    class Builder {
+    private:
+        List& list;
+        Node* first;
+        Node* last;
+        int count;
+
+    public:
+        explicit Builder(List& target) : list(target), first(nullptr), last(nullptr), count(0) {}
+        ~Builder() { finish(); }
+
+        Builder(const Builder&) = delete;
+        Builder& operator=(const Builder&) = delete;
+
+        void push(int n) {
+            Node* new_node = new Node(n, nullptr);
+            if (last == nullptr) first = new_node;
+            else last->set_next(new_node);
+            last = new_node;
+            ++count;
+        }
+
+        void finish() {
+            if (first == nullptr) return;
+
+            if (list.list_tail == nullptr) list.list_head = first;
+            else list.list_tail->set_next(first);
+            list.list_tail = last;
+            list.list_size += count;
+            if (list.summary.enabled()) {
+                for (Node* ptr = first; ptr != nullptr; ptr = ptr->next())
+                    list.summary.add(ptr->retrieve());
+            }
+
+            first = last = nullptr;
+            count = 0;
+        }
+    };
+
+    // Keeps a summary of the values (see ValueSummary) from now on, built
+    // from the current contents in one walk. SUMMARY_NONE drops it.
+    void enable_summary(SummaryMode mode, int bloom_counters = 1 << 16) {
+        summary.reset(mode, bloom_counters);
+        for (Node* ptr = list_head; ptr != nullptr; ptr = ptr->next())
+            summary.add(ptr->retrieve());
+    }
+
+    SummaryStats summary_stats() const {
+        return summary.stats();
     }
 
 
@@ -38,30 +489,42 @@ public:
     }
 
     int size() const {
-        int count = 0;
-        for (Node* ptr = list_head; ptr != nullptr; ptr = ptr->next())
-            ++count;
-        return count;
+        return list_size;
+    }
+
+    // Unchecked variants: the caller guarantees the list is not empty.
+    int front_unchecked() const {
+        return list_head->retrieve();
+    }
+
+    int end_unchecked() const {
+        return list_tail->retrieve();
     }
 
     int front() const {
         if (empty()) {
-            cerr << "List is empty! Cannot access front element.\n";
+            log_error("List is empty! Cannot access front element.\n");
             return -1;
         }
-        return list_head->retrieve();
+        return front_unchecked();
     }
 
     int end() const {
         if (empty()) {
-            cerr << "List is empty! Cannot access end element.\n";
+            log_error("List is empty! Cannot access end element.\n");
             return -1;
         }
+        return end_unchecked();
+    }
 
-        Node* ptr = list_head;
-        while (ptr->next() != nullptr)
-            ptr = ptr->next();
-        return ptr->retrieve();
+    optional<int> try_front() const {
+        if (empty()) return nullopt;
+        return front_unchecked();
+    }
+
+    optional<int> try_end() const {
+        if (empty()) return nullopt;
+        return end_unchecked();
     }
 
     Node* head() const {
@@ -69,118 +532,165 @@ public:
     }
 
     int count(int n) const {
+        int known = summary.lookup(n);
+        if (known >= 0) return known;
+
         int node_count = 0;
         for (Node* ptr = head(); ptr != nullptr; ptr = ptr->next()) {
             if (ptr->retrieve() == n)
                 ++node_count;
         }
+        summary.note_scan(node_count);
         return node_count;
     }
 
     void push_front(int n) {
         Node* new_node = new Node(n, list_head);
         list_head = new_node;
+        if (list_tail == nullptr) list_tail = new_node;
+        ++list_size;
+        ++finger_index;
+        summary.add(n);
     }
 
     void push_end(int n) {
         Node* new_node = new Node(n, nullptr);
+        summary.add(n);
+        ++list_size;
 
         if (empty()) {
-            list_head = new_node;
+            list_head = list_tail = new_node;
             return;
         }
 
-        Node* ptr = list_head;
-        while (ptr->next() != nullptr)
-            ptr = ptr->next();
-        ptr->set_next(new_node);
+        list_tail->set_next(new_node);
+        list_tail = new_node;
     }
 
     void push_between(int index, int n) {
+        if (!try_push_between(index, n))
+            log_index_error(size());
+    }
+
+    // Sequential positions (i, i + 1, ...) cost O(1) each thanks to the finger.
+    bool try_push_between(int index, int n) {
         int size_val = size();
 
         if (index < 0 || index > size_val) {
-            cerr << "Invalid index! Must be between 0 and " << size_val << ".\n";
-            return;
+            return false;
         }
 
        
         if (index == 0) {
             push_front(n);
-            return;
+            return true;
         }
 
         
         if (index == size_val) {
             push_end(n);
-            return;
-        }
-
-        Node* ptr = list_head;
-        for (int i = 0; i < index - 1; ++i) {
-            ptr = ptr->next();
+            return true;
         }
 
+        Node* ptr = node_at(index - 1);
         Node* new_node = new Node(n, ptr->next());
         ptr->set_next(new_node);
-    }
+        ++list_size;
+        summary.add(n);
 
-    int pop_front() {
-        if (empty()) {
-            cerr << "List is empty! Cannot pop front.\n";
-            return -1;
-        }
+        finger_node = new_node;
+        finger_index = index;
+        return true;
+    }
 
+    int pop_front_unchecked() {
         int value = list_head->retrieve();
         Node* temp = list_head;
         list_head = list_head->next();
+        if (list_head == nullptr) list_tail = nullptr;
+        if (finger_node == temp) reset_finger();
+        --finger_index;
+        --list_size;
         delete temp;
+        summary.remove(value);
         return value;
     }
 
-    int pop_end() {
-        if (empty()) {
-            cerr << "List is empty! Cannot pop end.\n";
-            return -1;
-        }
-
- 
+    // Still a walk to the node before the tail (from the finger when it is
+    // not past it): a singly linked node cannot find its predecessor.
+    int pop_end_unchecked() {
         if (list_head->next() == nullptr) {
             int value = list_head->retrieve();
             delete list_head;
-            list_head = nullptr;
+            list_head = list_tail = nullptr;
+            list_size = 0;
+            reset_finger();
+            summary.remove(value);
             return value;
         }
 
-       
-        Node* ptr = list_head;
-        while (ptr->next()->next() != nullptr)
-            ptr = ptr->next();
+        if (finger_node == list_tail) reset_finger();
+        Node* ptr = node_at(list_size - 2);
 
-        int value = ptr->next()->retrieve();
-        delete ptr->next();
+        int value = list_tail->retrieve();
+        delete list_tail;
         ptr->set_next(nullptr);
+        list_tail = ptr;
+        --list_size;
+        summary.remove(value);
         return value;
     }
 
-  
+    int pop_front() {
+        if (empty()) {
+            log_error("List is empty! Cannot pop front.\n");
+            return -1;
+        }
+        return pop_front_unchecked();
+    }
+
+    int pop_end() {
+        if (empty()) {
+            log_error("List is empty! Cannot pop end.\n");
+            return -1;
+        }
+        return pop_end_unchecked();
+    }
+
+    optional<int> try_pop_front() {
+        if (empty()) return nullopt;
+        return pop_front_unchecked();
+    }
+
+    optional<int> try_pop_end() {
+        if (empty()) return nullopt;
+        return pop_end_unchecked();
+    }
+
+    // With a summary, an absent value returns at once, and in exact mode the
+    // walk stops after the last occurrence.
     int erase(int n) {
+        int known = summary.lookup(n);
+        if (known == 0) return 0;
         int count_removed = 0;
 
       
+        reset_finger();
         while (list_head != nullptr && list_head->retrieve() == n) {
             Node* temp = list_head;
             list_head = list_head->next();
             delete temp;
             ++count_removed;
         }
+        if (list_head == nullptr) list_tail = nullptr;
 
      
         Node* ptr = list_head;
-        while (ptr != nullptr && ptr->next() != nullptr) {
+        while (ptr != nullptr && ptr->next() != nullptr && count_removed != known) {
             if (ptr->next()->retrieve() == n) {
                 Node* temp = ptr->next();
                 ptr->next_node = ptr->next()->next();  
+                if (temp == list_tail) list_tail = ptr;
                 delete temp;
                 ++count_removed;
             } else {
@@ -188,9 +698,164 @@ public:
             }
         }
 
+        list_size -= count_removed;
+        for (int i = 0; i < count_removed; ++i)
+            summary.remove(n);
+        if (known < 0) summary.note_scan(count_removed);
+        return count_removed;
+    }
+
+    // Removes every value for which pred is true in a single pass.
+    template <typename Pred>
+    int erase_if(Pred pred) {
+        int count_removed = 0;
+        Node* garbage = nullptr;
+        Node* prev = nullptr;
+        Node* ptr = list_head;
+
+        while (ptr != nullptr) {
+            Node* next_node = ptr->next();
+            if (pred(ptr->retrieve())) {
+                if (prev == nullptr) list_head = next_node;
+                else prev->set_next(next_node);
+                if (ptr == list_tail) list_tail = prev;
+                ptr->set_next(garbage);
+                garbage = ptr;
+                summary.remove(ptr->retrieve());
+                ++count_removed;
+            } else {
+                prev = ptr;
+            }
+            ptr = next_node;
+        }
+
+        list_size -= count_removed;
+        reset_finger();
+        free_chain(garbage);
         return count_removed;
     }
 
+    // Collapses runs of equal neighbouring values to one node.
+    int unique() {
+        int count_removed = 0;
+        Node* garbage = nullptr;
+        Node* ptr = list_head;
+
+        while (ptr != nullptr && ptr->next() != nullptr) {
+            Node* next_node = ptr->next();
+            if (next_node->retrieve() == ptr->retrieve()) {
+                ptr->set_next(next_node->next());
+                if (next_node == list_tail) list_tail = ptr;
+                next_node->set_next(garbage);
+                garbage = next_node;
+                summary.remove(next_node->retrieve());
+                ++count_removed;
+            } else {
+                ptr = next_node;
+            }
+        }
+
+        list_size -= count_removed;
+        reset_finger();
+        free_chain(garbage);
+        return count_removed;
+    }
+
+    // Moves the nodes for which pred is true, in order, to the end of matching;
+    // the rest stay here. Nodes are relinked, never copied.
+    template <typename Pred>
+    void partition(Pred pred, List& matching) {
+        if (&matching == this) return;
+
+        Node* prev = nullptr;
+        Node* ptr = list_head;
+        while (ptr != nullptr) {
+            Node* next_node = ptr->next();
+            if (pred(ptr->retrieve())) {
+                if (prev == nullptr) list_head = next_node;
+                else prev->set_next(next_node);
+                ptr->set_next(nullptr);
+                if (matching.list_tail == nullptr) matching.list_head = ptr;
+                else matching.list_tail->set_next(ptr);
+                matching.list_tail = ptr;
+                --list_size;
+                ++matching.list_size;
+                summary.remove(ptr->retrieve());
+                matching.summary.add(ptr->retrieve());
+            } else {
+                prev = ptr;
+            }
+            ptr = next_node;
+        }
+
+        list_tail = prev;
+        reset_finger();
+    }
+
+    // Removes positions [first, last); a range running past the end stops there.
+    int remove_range(int first, int last) {
+        if (first < 0 || last < first) {
+            log_error("Invalid range! Need 0 <= first <= last.\n");
+            return 0;
+        }
+
+        Node* prev = nullptr;
+        Node* ptr = list_head;
+        for (int i = 0; i < first && ptr != nullptr; ++i) {
+            prev = ptr;
+            ptr = ptr->next();
+        }
+
+        Node* garbage = ptr;
+        int count_removed = 0;
+        Node* garbage_tail = nullptr;
+        while (ptr != nullptr && count_removed < last - first) {
+            garbage_tail = ptr;
+            summary.remove(ptr->retrieve());
+            ptr = ptr->next();
+            ++count_removed;
+        }
+        if (count_removed == 0) return 0;
+
+        garbage_tail->set_next(nullptr);
+        if (prev == nullptr) list_head = ptr;
+        else prev->set_next(ptr);
+        if (ptr == nullptr) list_tail = prev;
+        list_size -= count_removed;
+
+        reset_finger();
+        free_chain(garbage);
+        return count_removed;
+    }
+
+
+    // Buffered alternative to display() for large lists. DUMP_TEXT matches the
+    // display() format, DUMP_CSV writes comma-separated values and DUMP_BINARY
+    // the raw ints. A non-negative limit keeps only the first limit values, or
+    // the last ones when from_back is set. Returns false, after logging it,
+    // if the output could not be written.
+    bool dump(int fd, DumpFormat format = DUMP_TEXT, int limit = -1, bool from_back = false) const {
+        DumpWriter out(fd, format);
+        if (empty()) {
+            out.text("List is empty.\n");
+            return finish_dump(out);
+        }
+
+        int skip = (limit >= 0 && from_back) ? size() - limit : 0;
+        Node* ptr = list_head;
+        for (int i = 0; i < skip; ++i)
+            ptr = ptr->next();
+
+        out.open("", " -> ");
+        if (skip > 0) out.omitted();
+        for (int shown = 0; ptr != nullptr && (limit < 0 || shown < limit); ++shown) {
+            out.value(ptr->retrieve());
+            ptr = ptr->next();
+        }
+        if (ptr != nullptr) out.omitted();
+        out.close(" -> nullptr\n");
+        return finish_dump(out);
+    }
 
     void display() const {
         if (empty()) {
@@ -237,6 +902,132 @@ int main() {
     cout << "\nIs list empty? " << (lst.empty() ? "Yes" : "No") << endl;
     cout << "Final size of list: " << lst.size() << endl;
 
+    cout << "\nDraining with try_pop_front:\n";
+    while (optional<int> value = lst.try_pop_front())
+        cout << "Popped " << *value << endl;
+    cout << "try_front on empty list has value? " << (lst.try_front() ? "Yes" : "No") << endl;
+    cout << "try_push_between(5, 1) succeeded? " << (lst.try_push_between(5, 1) ? "Yes" : "No") << endl;
+
+    cout << "\nBulk operations on 1, 1, 2, 3, 3, 4, 5, 6:\n";
+    lst.push_end(1);
+    lst.push_end(1);
+    lst.push_end(2);
+    lst.push_end(3);
+    lst.push_end(3);
+    lst.push_end(4);
+    lst.push_end(5);
+    lst.push_end(6);
+    cout << "unique() removed " << lst.unique() << ": ";
+    lst.display();
+
+    List evens;
+    lst.partition([](int n) { return n % 2 == 0; }, evens);
+    cout << "partition(even) left: ";
+    lst.display();
+    cout << "and moved: ";
+    evens.display();
+
+    cout << "remove_range(1, 3) removed " << evens.remove_range(1, 3) << ": ";
+    evens.display();
+    cout << "erase_if(> 2) removed " << lst.erase_if([](int n) { return n > 2; }) << ": ";
+    lst.display();
+    lst.pop_front();
+
+    cout << "\nDumping the list as CSV and the first 2 values as text:\n";
+    lst.push_front(3);
+    lst.push_front(2);
+    lst.push_front(1);
+    lst.dump(STDOUT_FILENO, DUMP_CSV);
+    lst.dump(STDOUT_FILENO, DUMP_TEXT, 2);
+    bool dumped = lst.dump(-1);
+    cout << "Dump to a closed descriptor succeeded? " << (dumped ? "Yes" : "No") << endl;
+
+    const int N = 10000000;
+    List big;
+    for (int i = 0; i < N; ++i)
+        big.push_front(i);
+
+    int null_fd = open("/dev/null", O_WRONLY);
+    auto start = chrono::steady_clock::now();
+    big.dump(null_fd);
+    auto dump_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    close(null_fd);
+    cout << "Text dump of " << N << " values: " << dump_time << " ms\n";
+
+    const int M = 100000;
+    const int QUERIES = 2000;
+    cout << "\ncount() of " << QUERIES << " mostly absent values over " << M << " nodes:\n";
+    List probe;
+    for (int i = 0; i < M; ++i)
+        probe.push_front(i * 2);
+
+    SummaryMode modes[] = { SUMMARY_NONE, SUMMARY_EXACT, SUMMARY_BLOOM };
+    const char* names[] = { "no summary", "exact", "bloom" };
+    for (int m = 0; m < 3; ++m) {
+        probe.enable_summary(modes[m], 1 << 20);
+        long long hits = 0;
+        start = chrono::steady_clock::now();
+        for (int q = 0; q < QUERIES; ++q)
+            hits += probe.count((q % 100 == 0) ? q : 2 * M + q);   // one in 100 is present
+        auto count_time = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+        SummaryStats stats = probe.summary_stats();
+        cout << names[m] << ": " << count_time / QUERIES << " us per count (" << hits << " hits), "
+             << stats.memory_bytes << " bytes, " << stats.ruled_out << " ruled out";
+        if (modes[m] == SUMMARY_BLOOM)
+            cout << ", false positives " << stats.false_positive_rate
+                 << " (expected " << stats.expected_false_positive_rate << ")";
+        cout << endl;
+    }
+
+    const int APPENDS = 1000000;
+    cout << "\nBuilding lists of " << APPENDS << " values:\n";
+
+    start = chrono::steady_clock::now();
+    {
+        List built;
+        for (int i = 0; i < APPENDS; ++i)
+            built.push_end(i);
+    }
+    auto push_end_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    {
+        List built;
+        for (int i = 0; i < APPENDS; ++i)
+            built.push_between(i, i);
+    }
+    auto between_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    {
+        List built;
+        List::Builder builder(built);
+        for (int i = 0; i < APPENDS; ++i)
+            builder.push(i);
+    }
+    auto builder_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    // What every append used to cost: a walk from the head to the last node.
+    const int WALKED = 20000;
+    start = chrono::steady_clock::now();
+    {
+        List walked;
+        walked.push_end(0);
+        for (int i = 1; i < WALKED; ++i) {
+            Node* ptr = walked.head();
+            while (ptr->next() != nullptr)
+                ptr = ptr->next();
+            walked.push_end(ptr->retrieve() + 1);
+        }
+    }
+    auto walked_time = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    cout << "push_end with cached tail: " << push_end_time << " ms\n";
+    cout << "push_between(i, ...) with the finger: " << between_time << " ms\n";
+    cout << "Builder: " << builder_time << " ms\n";
+    cout << "Walking from the head, only " << WALKED << " appends: " << walked_time << " ms\n";
+
     cout << "\nProgram finished successfully.\n";
 
     return 0;
@@ -0,0 +1,613 @@
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+using namespace std;
+
+const int MAX_SIZE = 100;              // StaticStack capacity, as in stack with static array.cpp
+const int FIRST_BLOCK = 4;             // ints in a stack's first block
+const int SIZE_CLASSES = 28;           // blocks hold FIRST_BLOCK << 0 .. FIRST_BLOCK << 27 ints
+const int OVERFLOW_CHUNK = 1 << 16;    // ints in the first overflow chunk
+
+class StackArena;
+
+// Handle to one stack inside a StackArena. It is two words and can be copied
+// freely; every copy refers to the same stack. Handles go stale at the
+// arena's next reset(), and the checked methods throw if used after that.
+class ArenaStack {
+private:
+    StackArena* arena;
+    int id;
+    unsigned int generation;
+
+    ArenaStack(StackArena* a, int stack_id, unsigned int gen) : arena(a), id(stack_id), generation(gen) {}
+    void check() const;
+
+public:
+    ArenaStack() : arena(nullptr), id(-1), generation(0) {}
+
+    bool empty() const;
+    int size() const;
+    void push(int n);
+
+    // Unchecked variants: the caller guarantees the stack is not empty and
+    // the handle is current.
+    int pop_unchecked();
+    int top_unchecked() const;
+
+    int pop();
+    int top() const;
+    optional<int> try_pop();
+    optional<int> try_top() const;
+
+    // Empties the stack and hands its block back to the arena for reuse.
+    void clear();
+
+    void display() const;
+
+    friend class StackArena;
+};
+
+// Many small stacks in one buffer, run as a buddy allocator. Each stack owns
+// a block of FIRST_BLOCK << k ints, aligned to its own size inside its region
+// (the main buffer or an overflow chunk). When a stack fills up it doubles in
+// place if the buddy block after it is free or not yet handed out, and
+// otherwise moves into a block twice the size. A freed block merges with its
+// free buddy, so the gaps that growing stacks leave behind add up to blocks
+// the next, larger stacks can use, and a request for a small block splits a
+// larger free one before taking new space. New space comes from the end of
+// the main buffer, then from overflow chunks once it is used up. reset()
+// forgets every stack at once; nothing is freed per stack, and the buffer and
+// chunks are kept for the next round.
+class StackArena {
+private:
+    struct StackInfo {
+        int* data;
+        int capacity;
+        int count;
+    };
+
+    // tags holds one byte per FIRST_BLOCK ints: class + 1 where a free block
+    // starts, 0 elsewhere. Only [0, used) is handed out and tagged; tags
+    // above it are stale and get cleared as the space is handed out.
+    struct Region {
+        int* data;
+        int size;
+        int used;
+        unsigned char* tags;
+    };
+
+    Region* regions;                // regions[0] is the main buffer
+    int region_count;
+    int region_slots;
+    int current_region;             // new space is taken from here on
+
+    int* free_list[SIZE_CLASSES];   // doubly linked through the first bytes of each block
+
+    StackInfo* stacks;
+    int stack_count;
+    int stack_capacity;
+    unsigned int generation;
+
+    static const int LINK_INTS = (int)(sizeof(void*) / sizeof(int));   // ints taken by one link
+    static_assert(2 * sizeof(int*) <= FIRST_BLOCK * sizeof(int), "a free block must hold its two links");
+
+    static int size_class(int capacity) {
+        return __builtin_ctz((unsigned int)(capacity / FIRST_BLOCK));
+    }
+
+    static int* next_free(int* block) {
+        int* p;
+        memcpy(&p, block, sizeof(p));
+        return p;
+    }
+
+    static int* prev_free(int* block) {
+        int* p;
+        memcpy(&p, block + LINK_INTS, sizeof(p));
+        return p;
+    }
+
+    static void set_next_free(int* block, int* p) { memcpy(block, &p, sizeof(p)); }
+    static void set_prev_free(int* block, int* p) { memcpy(block + LINK_INTS, &p, sizeof(p)); }
+
+    Region& region_of(int* block) {
+        int i = 0;
+        while (block < regions[i].data || block >= regions[i].data + regions[i].size)
+            ++i;
+        return regions[i];
+    }
+
+    void push_free(Region& r, int* block, int cls) {
+        set_next_free(block, free_list[cls]);
+        set_prev_free(block, nullptr);
+        if (free_list[cls] != nullptr) set_prev_free(free_list[cls], block);
+        free_list[cls] = block;
+        r.tags[(block - r.data) / FIRST_BLOCK] = (unsigned char)(cls + 1);
+    }
+
+    void remove_free(Region& r, int* block, int cls) {
+        int* next = next_free(block);
+        int* prev = prev_free(block);
+        if (prev != nullptr) set_next_free(prev, next);
+        else free_list[cls] = next;
+        if (next != nullptr) set_prev_free(next, prev);
+        r.tags[(block - r.data) / FIRST_BLOCK] = 0;
+    }
+
+    // Hands [from, to) of r to the free lists in the largest aligned pieces.
+    void release_gap(Region& r, int from, int to) {
+        memset(r.tags + from / FIRST_BLOCK, 0, (to - from) / FIRST_BLOCK);
+        while (from < to) {
+            // The largest block aligned at from; offset 0 is aligned for any size.
+            int cls = (from == 0) ? SIZE_CLASSES - 1 : size_class(from & -from);
+            while ((FIRST_BLOCK << cls) > to - from)
+                --cls;
+            push_free(r, r.data + from, cls);
+            from += FIRST_BLOCK << cls;
+        }
+    }
+
+    void add_region(int min_size) {
+        if (region_count == region_slots) {
+            int new_slots = (region_slots == 0) ? 4 : region_slots * 2;
+            Region* new_regions = new Region[new_slots];
+            if (region_count > 0) memcpy(new_regions, regions, region_count * sizeof(Region));
+            delete[] regions;
+            regions = new_regions;
+            region_slots = new_slots;
+        }
+
+        int new_size = (region_count <= 1) ? OVERFLOW_CHUNK : regions[region_count - 1].size * 2;
+        while (new_size < min_size)
+            new_size *= 2;
+        regions[region_count] = { new int[new_size], new_size, 0, new unsigned char[new_size / FIRST_BLOCK] };
+        ++region_count;
+    }
+
+    // New space, aligned to its size. The alignment gap, and the tail of a
+    // region too small for the block, go to the free lists.
+    int* allocate_new(int cls) {
+        int size = FIRST_BLOCK << cls;
+        while (true) {
+            if (current_region == region_count) add_region(size);
+
+            Region& r = regions[current_region];
+            int start = (r.used + size - 1) & -size;
+            if (start + size <= r.size) {
+                release_gap(r, r.used, start);
+                memset(r.tags + start / FIRST_BLOCK, 0, size / FIRST_BLOCK);
+                r.used = start + size;
+                return r.data + start;
+            }
+
+            int end = r.size & -FIRST_BLOCK;
+            if (r.used < end) release_gap(r, r.used, end);
+            r.used = end;
+            ++current_region;
+        }
+    }
+
+    int* allocate_block(int cls) {
+        for (int c = cls; c < SIZE_CLASSES; ++c) {
+            int* block = free_list[c];
+            if (block == nullptr) continue;
+
+            Region& r = region_of(block);
+            remove_free(r, block, c);
+            while (c > cls) {
+                --c;
+                push_free(r, block + (FIRST_BLOCK << c), c);
+            }
+            return block;
+        }
+        return allocate_new(cls);
+    }
+
+    void free_block(int* block, int cls) {
+        Region& r = region_of(block);
+        int offset = (int)(block - r.data);
+        while (cls + 1 < SIZE_CLASSES) {
+            int size = FIRST_BLOCK << cls;
+            int buddy = offset ^ size;
+            if (buddy + size > r.used || r.tags[buddy / FIRST_BLOCK] != cls + 1) break;
+            remove_free(r, r.data + buddy, cls);
+            offset &= ~size;
+            ++cls;
+        }
+        push_free(r, r.data + offset, cls);
+    }
+
+    // Doubles a block without moving it when its buddy is the block right
+    // after it and that buddy is free or not handed out yet.
+    bool grow_in_place(StackInfo& s) {
+        Region& r = region_of(s.data);
+        int offset = (int)(s.data - r.data);
+        int buddy = offset + s.capacity;
+        if (offset % (2 * s.capacity) != 0) return false;
+
+        if (buddy == r.used && &r == &regions[current_region] && buddy + s.capacity <= r.size) {
+            memset(r.tags + buddy / FIRST_BLOCK, 0, s.capacity / FIRST_BLOCK);
+            r.used += s.capacity;
+            return true;
+        }
+        if (buddy + s.capacity <= r.used && r.tags[buddy / FIRST_BLOCK] == size_class(s.capacity) + 1) {
+            remove_free(r, r.data + buddy, size_class(s.capacity));
+            return true;
+        }
+        return false;
+    }
+
+    void grow(StackInfo& s) {
+        int cls = (s.capacity == 0) ? 0 : size_class(s.capacity) + 1;
+        if (cls >= SIZE_CLASSES) {
+            throw length_error("Arena stack too large");
+        }
+
+        if (s.capacity > 0 && grow_in_place(s)) {
+            s.capacity *= 2;
+            return;
+        }
+
+        int* block = allocate_block(cls);
+        if (s.count > 0) memcpy(block, s.data, s.count * sizeof(int));
+        if (s.capacity > 0) free_block(s.data, cls - 1);
+        s.data = block;
+        s.capacity = FIRST_BLOCK << cls;
+    }
+
+    StackInfo& info(int id) { return stacks[id]; }
+    const StackInfo& info(int id) const { return stacks[id]; }
+
+public:
+    explicit StackArena(int initial_ints = 1 << 20)
+        : regions(nullptr), region_count(0), region_slots(0), current_region(0),
+          stacks(nullptr), stack_count(0), stack_capacity(0), generation(0) {
+        for (int i = 0; i < SIZE_CLASSES; ++i)
+            free_list[i] = nullptr;
+
+        add_region(0);
+        initial_ints &= -FIRST_BLOCK;
+        delete[] regions[0].data;
+        delete[] regions[0].tags;
+        regions[0] = { new int[initial_ints], initial_ints, 0, new unsigned char[initial_ints / FIRST_BLOCK] };
+    }
+
+    ~StackArena() {
+        for (int i = 0; i < region_count; ++i) {
+            delete[] regions[i].data;
+            delete[] regions[i].tags;
+        }
+        delete[] regions;
+        delete[] stacks;
+    }
+
+    StackArena(const StackArena&) = delete;
+    StackArena& operator=(const StackArena&) = delete;
+
+    // New empty stack. It takes no buffer space until its first push.
+    ArenaStack create() {
+        if (stack_count == stack_capacity) {
+            int new_capacity = (stack_capacity == 0) ? 1024 : stack_capacity * 2;
+            StackInfo* new_stacks = new StackInfo[new_capacity];
+            if (stack_count > 0) memcpy(new_stacks, stacks, stack_count * sizeof(StackInfo));
+            delete[] stacks;
+            stacks = new_stacks;
+            stack_capacity = new_capacity;
+        }
+
+        stacks[stack_count] = { nullptr, 0, 0 };
+        return ArenaStack(this, stack_count++, generation);
+    }
+
+    // Drops every stack and invalidates all handles, in time independent of
+    // the number of stacks. Memory is kept.
+    void reset() {
+        stack_count = 0;
+        for (int i = 0; i < region_count; ++i)
+            regions[i].used = 0;
+        current_region = 0;
+        for (int i = 0; i < SIZE_CLASSES; ++i)
+            free_list[i] = nullptr;
+        ++generation;
+    }
+
+    int stacks_created() const { return stack_count; }
+    int overflow_chunks() const { return region_count - 1; }
+
+    // Everything the arena holds, reserved or not.
+    long long memory_bytes() const {
+        long long bytes = (long long)stack_capacity * sizeof(StackInfo);
+        for (int i = 0; i < region_count; ++i)
+            bytes += (long long)regions[i].size * sizeof(int) + regions[i].size / FIRST_BLOCK;
+        return bytes;
+    }
+
+    // Space handed out since the last reset (free blocks included), with its
+    // tags, plus the per-stack descriptors.
+    long long used_bytes() const {
+        long long bytes = (long long)stack_count * sizeof(StackInfo);
+        for (int i = 0; i < region_count; ++i)
+            bytes += (long long)regions[i].used * sizeof(int) + regions[i].used / FIRST_BLOCK;
+        return bytes;
+    }
+
+    friend class ArenaStack;
+};
+
+void ArenaStack::check() const {
+    if (arena == nullptr || generation != arena->generation) {
+        throw logic_error("Stale arena stack handle");
+    }
+}
+
+bool ArenaStack::empty() const {
+    check();
+    return arena->info(id).count == 0;
+}
+
+int ArenaStack::size() const {
+    check();
+    return arena->info(id).count;
+}
+
+void ArenaStack::push(int n) {
+    check();
+    StackArena::StackInfo& s = arena->info(id);
+    if (s.count == s.capacity) {
+        arena->grow(s);
+    }
+    s.data[s.count++] = n;
+}
+
+int ArenaStack::pop_unchecked() {
+    StackArena::StackInfo& s = arena->info(id);
+    return s.data[--s.count];
+}
+
+int ArenaStack::top_unchecked() const {
+    const StackArena::StackInfo& s = arena->info(id);
+    return s.data[s.count - 1];
+}
+
+int ArenaStack::pop() {
+    if (empty()) {
+        throw out_of_range("Pop on empty stack");
+    }
+    return pop_unchecked();
+}
+
+int ArenaStack::top() const {
+    if (empty()) {
+        throw out_of_range("Top on empty stack");
+    }
+    return top_unchecked();
+}
+
+optional<int> ArenaStack::try_pop() {
+    if (empty()) return nullopt;
+    return pop_unchecked();
+}
+
+optional<int> ArenaStack::try_top() const {
+    if (empty()) return nullopt;
+    return top_unchecked();
+}
+
+void ArenaStack::clear() {
+    check();
+    StackArena::StackInfo& s = arena->info(id);
+    if (s.capacity > 0) arena->free_block(s.data, StackArena::size_class(s.capacity));
+    s = { nullptr, 0, 0 };
+}
+
+void ArenaStack::display() const {
+    if (empty()) return;
+    const StackArena::StackInfo& s = arena->info(id);
+    cout << "TOP -> ";
+    for (int i = s.count - 1; i >= 0; --i) {
+        cout << s.data[i] << (i > 0 ? " -> " : "");
+    }
+    cout << " -> BOTTOM\n";
+}
+
+// What glibc's malloc takes for an n-byte request: an 8-byte header, rounded
+// up to 16 bytes, 32 at least.
+long long heap_block_bytes(long long n) {
+    long long bytes = (n + 8 + 15) & ~15LL;
+    return (bytes < 32) ? 32 : bytes;
+}
+
+// Cut-down copies of the array stacks for the comparison below.
+class StaticStack {
+private:
+    int data[MAX_SIZE];
+    int top_index;
+
+public:
+    StaticStack() : top_index(-1) {}
+
+    void push(int n) {
+        if (top_index == MAX_SIZE - 1) {
+            throw overflow_error("Push on full stack");
+        }
+        data[++top_index] = n;
+    }
+
+    int pop_unchecked() { return data[top_index--]; }
+};
+
+class DynamicStack {
+private:
+    int* data;
+    int capacity;
+    int top_index;
+
+    void resize() {
+        int new_capacity = (capacity == 0) ? 1 : capacity * 2;
+        int* new_data = new int[new_capacity];
+
+        for (int i = 0; i < capacity; ++i) {
+            new_data[i] = data[i];
+        }
+
+        delete[] data;
+        data = new_data;
+        capacity = new_capacity;
+    }
+
+public:
+    DynamicStack() : data(nullptr), capacity(0), top_index(-1) {}
+    ~DynamicStack() { delete[] data; }
+
+    int size() const { return top_index + 1; }
+    long long memory_bytes() const {
+        return sizeof(*this) + ((capacity > 0) ? heap_block_bytes((long long)capacity * sizeof(int)) : 0);
+    }
+
+    void push(int n) {
+        if (size() == capacity) {
+            resize();
+        }
+        data[++top_index] = n;
+    }
+
+    int pop_unchecked() { return data[top_index--]; }
+};
+
+volatile long long benchmark_sink;   // keeps the benchmark loops from being optimized away
+
+const int STACKS = 50000;
+const int MAX_DEPTH = 24;
+
+int depth_of(int i) {
+    return 1 + (int)((i * 2654435761u) >> 16) % MAX_DEPTH;
+}
+
+// One "request": every stack is filled, then drained. Filled one stack after
+// another, the blocks a stack outgrows are picked up by the next one. Filled
+// round-robin, all stacks outgrow the same size at once; freed blocks only
+// merge when both buddies have moved, so part of the gaps stays unused until
+// reset(). That is the arena's worst case.
+template <typename Stack>
+long long fill_and_drain(Stack* stacks, bool interleaved) {
+    long long checksum = 0;
+    if (interleaved) {
+        for (int round = 0; round < MAX_DEPTH; ++round) {
+            for (int i = 0; i < STACKS; ++i) {
+                if (round < depth_of(i)) stacks[i].push(i + round);
+            }
+        }
+    }
+    else {
+        for (int i = 0; i < STACKS; ++i) {
+            for (int round = 0; round < depth_of(i); ++round)
+                stacks[i].push(i + round);
+        }
+    }
+    for (int i = 0; i < STACKS; ++i) {
+        for (int d = depth_of(i); d > 0; --d)
+            checksum += stacks[i].pop_unchecked();
+    }
+    return checksum;
+}
+
+int main() {
+    StackArena arena(256);
+
+    ArenaStack a = arena.create();
+    ArenaStack b = arena.create();
+    cout << "Pushing 1..6 on stack a and 10, 20 on stack b:\n";
+    for (int i = 1; i <= 6; ++i)
+        a.push(i);
+    b.push(10);
+    b.push(20);
+    a.display();
+    b.display();
+
+    cout << "Popped from a: " << a.pop() << ", top of b: " << b.top() << endl;
+    cout << "Sizes: " << a.size() << " and " << b.size() << endl;
+
+    b.clear();
+    cout << "try_pop on cleared b has value? " << (b.try_pop() ? "Yes" : "No") << endl;
+
+    arena.reset();
+    try {
+        a.push(7);
+    } catch (const logic_error& e) {
+        cout << "Using a after reset(): " << e.what() << endl;
+    }
+
+    const int REQUESTS = 20;
+    StackArena big_arena;
+    ArenaStack* handles = new ArenaStack[STACKS];
+
+    for (int pattern = 0; pattern < 2; ++pattern) {
+        bool interleaved = (pattern == 1);
+        cout << "\n" << REQUESTS << " requests of " << STACKS << " stacks, 1-" << MAX_DEPTH << " values each, filled "
+             << (interleaved ? "round-robin" : "one by one") << ":\n";
+
+        double arena_ms = 0.0;
+        double arena_teardown_ms = 0.0;
+        long long arena_bytes = 0;
+        for (int r = 0; r < REQUESTS; ++r) {
+            auto start = chrono::steady_clock::now();
+            for (int i = 0; i < STACKS; ++i)
+                handles[i] = big_arena.create();
+            benchmark_sink = fill_and_drain(handles, interleaved);
+            auto mid = chrono::steady_clock::now();
+            arena_bytes = big_arena.used_bytes();
+            mid = chrono::steady_clock::now();
+            big_arena.reset();
+            auto end = chrono::steady_clock::now();
+            arena_ms += chrono::duration<double, milli>(mid - start).count();
+            arena_teardown_ms += chrono::duration<double, milli>(end - mid).count();
+        }
+
+        double dynamic_ms = 0.0;
+        double dynamic_teardown_ms = 0.0;
+        long long dynamic_bytes = 0;
+        for (int r = 0; r < REQUESTS; ++r) {
+            auto start = chrono::steady_clock::now();
+            DynamicStack* stacks = new DynamicStack[STACKS];
+            benchmark_sink = fill_and_drain(stacks, interleaved);
+            auto mid = chrono::steady_clock::now();
+            dynamic_bytes = 0;
+            for (int i = 0; i < STACKS; ++i)
+                dynamic_bytes += stacks[i].memory_bytes();
+            mid = chrono::steady_clock::now();
+            delete[] stacks;
+            auto end = chrono::steady_clock::now();
+            dynamic_ms += chrono::duration<double, milli>(mid - start).count();
+            dynamic_teardown_ms += chrono::duration<double, milli>(end - mid).count();
+        }
+
+        double static_ms = 0.0;
+        for (int r = 0; r < REQUESTS; ++r) {
+            auto start = chrono::steady_clock::now();
+            StaticStack* stacks = new StaticStack[STACKS];
+            benchmark_sink = fill_and_drain(stacks, interleaved);
+            delete[] stacks;
+            static_ms += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        }
+
+        cout << "StackArena:   " << arena_ms / REQUESTS << " ms per request, teardown "
+             << arena_teardown_ms / REQUESTS << " ms, " << (double)arena_bytes / STACKS << " bytes per stack\n";
+        cout << "DynamicStack: " << dynamic_ms / REQUESTS << " ms per request, teardown "
+             << dynamic_teardown_ms / REQUESTS << " ms, " << (double)dynamic_bytes / STACKS
+             << " bytes per stack (glibc chunk sizes)\n";
+        cout << "StaticStack:  " << static_ms / REQUESTS << " ms per request including teardown, "
+             << sizeof(StaticStack) << " bytes per stack\n";
+        if (arena_bytes > dynamic_bytes)
+            cout << "The arena uses more memory per stack than DynamicStack here.\n";
+    }
+    delete[] handles;
+
+    cout << "Arena footprint: " << big_arena.memory_bytes() << " bytes, "
+         << big_arena.overflow_chunks() << " overflow chunks\n";
+
+    cout << "\nProgram finished successfully.\n";
+
+    return 0;
+}
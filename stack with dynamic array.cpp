@@ -1,7 +1,105 @@
 #include <iostream>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <optional>
 #include <stdexcept>
+#include <unistd.h>
 using namespace std;
 
+enum DumpFormat { DUMP_TEXT, DUMP_CSV, DUMP_BINARY };
+
+// Formats values with to_chars into one large buffer and hands it to write()
+// in big pieces, instead of one operator<< per element like display().
+class DumpWriter {
+private:
+    static const int BUFFER_SIZE = 1 << 16;
+    char buffer[BUFFER_SIZE];
+    int used;
+    int fd;
+    DumpFormat format;
+    const char* separator;
+    bool first_item;
+    bool failed;
+
+    // Retries partial writes and EINTR. Any other error, or a write that makes
+    // no progress, marks the writer failed and drops everything after it.
+    void flush() {
+        int done = 0;
+        while (done < used && !failed) {
+            ssize_t n = write(fd, buffer + done, used - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) failed = true;
+            else done += (int)n;
+        }
+        used = 0;
+    }
+
+    void put(const char* s, int len) {
+        if (used + len > BUFFER_SIZE) flush();
+        memcpy(buffer + used, s, len);
+        used += len;
+    }
+
+    void put(const char* s) { put(s, (int)strlen(s)); }
+
+    void next_item() {
+        if (!first_item) put(separator);
+        first_item = false;
+    }
+
+public:
+    DumpWriter(int out_fd, DumpFormat fmt)
+        : used(0), fd(out_fd), format(fmt), separator(","), first_item(true), failed(false) {
+        if (fd == STDOUT_FILENO) cout.flush();   // keep ordering with earlier cout output
+    }
+
+    ~DumpWriter() { flush(); }
+
+    // Writes out what is buffered; false if any of the output was lost.
+    bool finish() {
+        flush();
+        return !failed;
+    }
+
+    void text(const char* s) {
+        if (format == DUMP_TEXT) put(s);
+    }
+
+    void text_value(int n) {
+        if (format != DUMP_TEXT) return;
+        if (used + 11 > BUFFER_SIZE) flush();
+        used = (int)(to_chars(buffer + used, buffer + BUFFER_SIZE, n).ptr - buffer);
+    }
+
+    void open(const char* prefix, const char* text_separator) {
+        if (format == DUMP_TEXT) separator = text_separator;
+        text(prefix);
+    }
+
+    void value(int n) {
+        if (format == DUMP_BINARY) {
+            put((const char*)&n, (int)sizeof(n));
+            return;
+        }
+        next_item();
+        if (used + 11 > BUFFER_SIZE) flush();
+        used = (int)(to_chars(buffer + used, buffer + BUFFER_SIZE, n).ptr - buffer);
+    }
+
+    // Marks values cut off by a first/last N limit.
+    void omitted() {
+        if (format != DUMP_TEXT) return;
+        next_item();
+        put("...");
+    }
+
+    void close(const char* suffix) {
+        if (format == DUMP_TEXT) put(suffix);
+        else if (format == DUMP_CSV) put("\n");
+    }
+};
+
 class DynamicStack {
 private:
     int* data;
@@ -35,18 +133,55 @@ public:
         data[++top_index] = n;
     }
 
+    // Unchecked variants: the caller guarantees the stack is not empty.
+    int pop_unchecked() { return data[top_index--]; }
+    int top_unchecked() const { return data[top_index]; }
+
     int pop() {
         if (empty()) {
             throw out_of_range("Pop on empty stack");
         }
-        return data[top_index--]; 
+        return pop_unchecked(); 
     }
 
     int top() const {
         if (empty()) {
             throw out_of_range("Top on empty stack");
         }
-        return data[top_index]; 
+        return top_unchecked(); 
+    }
+
+    optional<int> try_pop() {
+        if (empty()) return nullopt;
+        return pop_unchecked();
+    }
+
+    optional<int> try_top() const {
+        if (empty()) return nullopt;
+        return top_unchecked();
+    }
+
+    // Buffered alternative to display() for large stacks, written top first.
+    // A non-negative limit keeps only the top limit values, or the bottom ones
+    // when from_back is set. Returns false if the output could not be written.
+    bool dump(int fd, DumpFormat format = DUMP_TEXT, int limit = -1, bool from_back = false) const {
+        if (empty()) return true;
+        DumpWriter out(fd, format);
+
+        int first = top_index;
+        int last = 0;
+        if (limit >= 0 && limit <= top_index) {
+            if (from_back) first = limit - 1;
+            else last = top_index - limit + 1;
+        }
+
+        out.open("TOP -> ", " -> ");
+        if (first < top_index) out.omitted();
+        for (int i = first; i >= last; --i)
+            out.value(data[i]);
+        if (last > 0) out.omitted();
+        out.close(" -> BOTTOM\n");
+        return out.finish();
     }
 
     void display() const {
@@ -65,7 +200,10 @@ int main() {
      s.push(2);
      s.push(3);
      s.display(); 
+     s.dump(STDOUT_FILENO, DUMP_CSV);
      cout << "Popped: " << s.pop() << endl; 
      s.display(); 
+     while (optional<int> value = s.try_pop())
+         cout << "Drained: " << *value << endl;
      return 0;
 }
@@ -1,6 +1,119 @@
 #include <iostream>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <optional>
+#include <unistd.h>
 using namespace std;
 
+// Kept out of line so pop()/top() stay a handful of instructions when inlined.
+// Build with -DNO_ERROR_LOG to drop the message.
+[[gnu::cold, gnu::noinline]] void log_error([[maybe_unused]] const char* msg) {
+#ifndef NO_ERROR_LOG
+    cerr << msg;
+#endif
+}
+
+enum DumpFormat { DUMP_TEXT, DUMP_CSV, DUMP_BINARY };
+
+// Formats values with to_chars into one large buffer and hands it to write()
+// in big pieces, instead of one operator<< per element like display().
+class DumpWriter {
+private:
+    static const int BUFFER_SIZE = 1 << 16;
+    char buffer[BUFFER_SIZE];
+    int used;
+    int fd;
+    DumpFormat format;
+    const char* separator;
+    bool first_item;
+    bool failed;
+
+    // Retries partial writes and EINTR. Any other error, or a write that makes
+    // no progress, marks the writer failed and drops everything after it.
+    void flush() {
+        int done = 0;
+        while (done < used && !failed) {
+            ssize_t n = write(fd, buffer + done, used - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) failed = true;
+            else done += (int)n;
+        }
+        used = 0;
+    }
+
+    void put(const char* s, int len) {
+        if (used + len > BUFFER_SIZE) flush();
+        memcpy(buffer + used, s, len);
+        used += len;
+    }
+
+    void put(const char* s) { put(s, (int)strlen(s)); }
+
+    void next_item() {
+        if (!first_item) put(separator);
+        first_item = false;
+    }
+
+public:
+    DumpWriter(int out_fd, DumpFormat fmt)
+        : used(0), fd(out_fd), format(fmt), separator(","), first_item(true), failed(false) {
+        if (fd == STDOUT_FILENO) cout.flush();   // keep ordering with earlier cout output
+    }
+
+    ~DumpWriter() { flush(); }
+
+    // Writes out what is buffered; false if any of the output was lost.
+    bool finish() {
+        flush();
+        return !failed;
+    }
+
+    void text(const char* s) {
+        if (format == DUMP_TEXT) put(s);
+    }
+
+    void text_value(int n) {
+        if (format != DUMP_TEXT) return;
+        if (used + 11 > BUFFER_SIZE) flush();
+        used = (int)(to_chars(buffer + used, buffer + BUFFER_SIZE, n).ptr - buffer);
+    }
+
+    void open(const char* prefix, const char* text_separator) {
+        if (format == DUMP_TEXT) separator = text_separator;
+        text(prefix);
+    }
+
+    void value(int n) {
+        if (format == DUMP_BINARY) {
+            put((const char*)&n, (int)sizeof(n));
+            return;
+        }
+        next_item();
+        if (used + 11 > BUFFER_SIZE) flush();
+        used = (int)(to_chars(buffer + used, buffer + BUFFER_SIZE, n).ptr - buffer);
+    }
+
+    // Marks values cut off by a first/last N limit.
+    void omitted() {
+        if (format != DUMP_TEXT) return;
+        next_item();
+        put("...");
+    }
+
+    void close(const char* suffix) {
+        if (format == DUMP_TEXT) put(suffix);
+        else if (format == DUMP_CSV) put("\n");
+    }
+};
+
+// Flushes a dump and reports a write that did not go through.
+bool finish_dump(DumpWriter& out) {
+    if (out.finish()) return true;
+    log_error("Dump failed! Could not write to the file descriptor.\n");
+    return false;
+}
+
 class Node {
 private:
     int value;
@@ -46,12 +159,8 @@ public:
     }
 
  
-    int pop() {
-        if (empty()) {
-            cerr << "Stack is empty! Cannot pop.\n";
-            return -1;
-        }
-
+    // Unchecked variants: the caller guarantees the stack is not empty.
+    int pop_unchecked() {
         int value = list_head->retrieve();
         Node* temp = list_head;
         list_head = list_head->next();
@@ -60,12 +169,61 @@ public:
         return value;
     }
 
+    int top_unchecked() const {
+        return list_head->retrieve();
+    }
+
+    int pop() {
+        if (empty()) {
+            log_error("Stack is empty! Cannot pop.\n");
+            return -1;
+        }
+        return pop_unchecked();
+    }
+
     int top() const {
         if (empty()) {
-            cerr << "Stack is empty! Cannot access top element.\n";
+            log_error("Stack is empty! Cannot access top element.\n");
             return -1;
         }
-        return list_head->retrieve();
+        return top_unchecked();
+    }
+
+    optional<int> try_pop() {
+        if (empty()) return nullopt;
+        return pop_unchecked();
+    }
+
+    optional<int> try_top() const {
+        if (empty()) return nullopt;
+        return top_unchecked();
+    }
+
+    // Buffered alternative to display() for large stacks, written top first.
+    // DUMP_TEXT matches display(); a non-negative limit keeps only the top
+    // limit values, or the bottom ones when from_back is set. Returns false,
+    // after logging it, if the output could not be written.
+    bool dump(int fd, DumpFormat format = DUMP_TEXT, int limit = -1, bool from_back = false) const {
+        DumpWriter out(fd, format);
+        if (empty()) {
+            out.text("Stack is empty.\n");
+            return finish_dump(out);
+        }
+
+        int skip = (limit >= 0 && from_back) ? stack_size - limit : 0;
+        Node* ptr = list_head;
+        for (int i = 0; i < skip; ++i)
+            ptr = ptr->next();
+
+        out.open("TOP -> ", " -> ");
+        if (skip > 0) out.omitted();
+        for (int shown = 0; ptr != nullptr && (limit < 0 || shown < limit); ++shown) {
+            out.value(ptr->retrieve());
+            ptr = ptr->next();
+        }
+        if (ptr != nullptr) out.omitted();
+        out.close(" -> BOTTOM\n");
+        return finish_dump(out);
     }
 
     void display() const {
@@ -92,6 +250,9 @@ int main() {
     s.push(30);
     s.display(); 
 
+    cout << "As CSV: ";
+    s.dump(STDOUT_FILENO, DUMP_CSV);
+
     cout << "\nTop element: " << s.top() << endl; 
     cout << "Size of stack: " << s.size() << endl;
 
@@ -108,6 +269,7 @@ int main() {
     s.display();
 
     cout << "\nIs stack empty? " << (s.empty() ? "Yes" : "No") << endl;
+    cout << "try_pop on empty stack has value? " << (s.try_pop() ? "Yes" : "No") << endl;
 
     cout << "\nProgram finished successfully.\n";
 